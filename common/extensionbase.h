@@ -50,6 +50,30 @@ protected:
      */
     Callback _onShutdown;
     
+    /**
+     *  The php.ini settings of the extension
+     *  @var    std::list
+     */
+    std::list<Ini> _ini;
+    
+    /**
+     *  The stream wrappers of the extension
+     *  @var    std::list
+     */
+    std::list<std::shared_ptr<StreamWrapper>> _wrappers;
+    
+    /**
+     *  Callback that adds rows to the phpinfo() output
+     *  @var    InfoCallback
+     */
+    InfoCallback _onInfo;
+    
+    /**
+     *  Should the calls to the functions be counted?
+     *  @var    bool
+     */
+    bool _instrument = false;
+    
 public:
     /**
      *  Constructor
@@ -129,6 +153,56 @@ public:
         // copy callback
         _onIdle = callback;
     }
+    
+    /**
+     *  Register a callback that adds rows to the phpinfo() output
+     *  @param  callback
+     */
+    void onInfo(const InfoCallback &callback)
+    {
+        // copy callback
+        _onInfo = callback;
+    }
+    
+    /**
+     *  Enable or disable counting the calls to the functions
+     *  @param  enabled
+     */
+    void instrument(bool enabled)
+    {
+        // store setting
+        _instrument = enabled;
+    }
+    
+    /**
+     *  Add a php.ini setting
+     *  @param  ini
+     */
+    void add(Ini &&ini)
+    {
+        // store the setting
+        _ini.push_back(std::move(ini));
+    }
+    
+    /**
+     *  Add a php.ini setting
+     *  @param  ini
+     */
+    void add(const Ini &ini)
+    {
+        // store the setting
+        _ini.push_back(ini);
+    }
+    
+    /**
+     *  Add a stream wrapper
+     *  @param  wrapper
+     */
+    void add(const std::shared_ptr<StreamWrapper> &wrapper)
+    {
+        // store the wrapper
+        _wrappers.push_back(wrapper);
+    }
 };
 
 /**
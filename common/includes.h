@@ -11,6 +11,7 @@
  *  Standard C and C++ libraries
  */
 #include <sstream>
+#include <vector>
 
 /**
  *  Public include files
@@ -18,12 +18,63 @@ namespace Php {
 /**
  *  Constructor
  *  @param  error
+ *  @param  size
  */
-StreamBuf::StreamBuf(int error) : _error(error)
+StreamBuf::StreamBuf(int error, size_t size) : _error(error)
 {
+    // allocate the buffer
+    setbuf(nullptr, size);
+}
+
+/**
+ *  Method that is called to change the buffer
+ *  @param  buffer
+ *  @param  size
+ *  @return std::streambuf
+ */
+std::streambuf *StreamBuf::setbuf(char *buffer, std::streamsize size)
+{
+    // we need room for at least one byte, and the byte that we reserve
+    if (size < 2) return nullptr;
+    
+    // write out the data in the current buffer
+    if (pbase()) sync();
+    
+    // allocate memory if no buffer was supplied
+    if (!buffer) _memory.resize(size);
+    if (!buffer) buffer = _memory.data();
+    
     // we reserve one byte, so that when overflow is called, we still have one
     // byte extra in the buffer to put the overflowed byte int
-    setp(_buffer, _buffer+1024-1);
+    setp(buffer, buffer+size-1);
+    
+    // done
+    return this;
+}
+
+/**
+ *  Method that is called to write multiple bytes at once
+ *  @param  data
+ *  @param  size
+ *  @return std::streamsize
+ */
+std::streamsize StreamBuf::xsputn(const char *data, std::streamsize size)
+{
+    // data that fits in the buffer is simply copied, and messages for the
+    // error streams always go through the buffer
+    if (_error || size <= epptr() - pptr()) return std::streambuf::xsputn(data, size);
+    
+    // write out the data that is already in the buffer
+    sync();
+    
+    // if the data is smaller than the buffer, we add it to the buffer
+    if (size <= epptr() - pptr()) return std::streambuf::xsputn(data, size);
+    
+    // big data is written directly, without copying it into the buffer first
+    write(data, size);
+    
+    // done
+    return size;
 }
     
 
@@ -53,6 +104,28 @@ int StreamBuf::overflow(int c)
     return sync() == -1 ? EOF : c;
 }
 
+/**
+ *  Called when the internal buffer should be synchronized
+ *  @return int
+ */
+int StreamBuf::sync()
+{
+    // current buffer size
+    size_t size = pptr() - pbase();
+    
+    // nothing to do if the buffer is empty
+    if (size == 0) return 0;
+    
+    // send the data to PHP
+    write(pbase(), size);
+    
+    // reset the buffer
+    pbump(-size);
+    
+    // done
+    return 0;
+}
+
 /**
  *  End namespace
  */
@@ -5,6 +5,9 @@
  *  have an output stream just like the regular std::ostream buffers, 
  *  but that sends all output to PHP output
  *
+ *  The size of the buffer can be changed with pubsetbuf(). Data that does
+ *  not fit in the buffer is not copied into it, but is written directly.
+ *
  *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
  *  @copyright 2014 Copernica BV
  */
@@ -23,8 +26,9 @@ public:
     /**
      *  Constructor
      *  @param  error   the error type, or 0 for regular output
+     *  @param  size    size of the buffer
      */
-    StreamBuf(int error);
+    StreamBuf(int error, size_t size = 1024);
     
     /**
      *  No copying or moving
@@ -58,6 +62,22 @@ protected:
      *  @return int
      */
     virtual int sync() override;
+    
+    /**
+     *  Method that is called to write multiple bytes at once
+     *  @param  data
+     *  @param  size
+     *  @return std::streamsize
+     */
+    virtual std::streamsize xsputn(const char *data, std::streamsize size) override;
+    
+    /**
+     *  Method that is called to change the buffer
+     *  @param  buffer  the new buffer, or nullptr to allocate one
+     *  @param  size    size of the new buffer
+     *  @return std::streambuf
+     */
+    virtual std::streambuf *setbuf(char *buffer, std::streamsize size) override;
 
 private:
     /**
@@ -67,10 +87,17 @@ private:
     int _error;
 
     /**
-     *  The internal buffer
-     *  @var    char[]
+     *  Memory for the buffer, when it was not supplied with pubsetbuf()
+     *  @var    std::vector
+     */
+    std::vector<char> _memory;
+    
+    /**
+     *  Send data to PHP
+     *  @param  data
+     *  @param  size
      */
-    char _buffer[1024];
+    void write(const char *data, size_t size);
 };
 
 /**
@@ -82,6 +82,76 @@ Extension &Extension::onIdle(const Callback &callback)
     return *this;
 }
 
+/**
+ *  Register a callback that adds rows to the phpinfo() output
+ *  @param  callback
+ *  @return Extension
+ */
+Extension &Extension::onInfo(const InfoCallback &callback)
+{
+    // pass on to the implementation
+    _impl->onInfo(callback);
+    
+    // allow chaining
+    return *this;
+}
+
+/**
+ *  Count the calls to the functions of the extension
+ *  @param  enabled
+ *  @return Extension
+ */
+Extension &Extension::instrument(bool enabled)
+{
+    // pass on to the implementation
+    _impl->instrument(enabled);
+    
+    // allow chaining
+    return *this;
+}
+
+/**
+ *  Add a php.ini setting to the extension
+ *  @param  ini
+ *  @return Extension
+ */
+Extension &Extension::add(Ini &&ini)
+{
+    // pass on to the implementation
+    _impl->add(std::move(ini));
+    
+    // allow chaining
+    return *this;
+}
+
+/**
+ *  Add a php.ini setting to the extension
+ *  @param  ini
+ *  @return Extension
+ */
+Extension &Extension::add(const Ini &ini)
+{
+    // pass on to the implementation
+    _impl->add(ini);
+    
+    // allow chaining
+    return *this;
+}
+
+/**
+ *  Add a stream wrapper to the extension
+ *  @param  wrapper
+ *  @return Extension
+ */
+Extension &Extension::add(const std::shared_ptr<StreamWrapper> &wrapper)
+{
+    // pass on to the implementation
+    _impl->add(wrapper);
+    
+    // allow chaining
+    return *this;
+}
+
 /**
  *  Retrieve the module pointer
  * 
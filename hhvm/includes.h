@@ -11,10 +11,12 @@
  *  Standard C and C++ libraries
  */
 #include <functional>
+#include <exception>
 #include <list>
 #include <memory>
 #include <vector>
 #include <map>
+#include <type_traits>
 #include <string.h>
 #include <iostream>
 
@@ -26,20 +28,40 @@
 /**
  *  Public include files
  */
+#include "../include/exception.h"
 #include "../include/type.h"
 #include "../include/hashparent.h"
 #include "../include/value.h"
 #include "../include/parameters.h"
 #include "../include/classtype.h"
+#include "../include/poolstatistics.h"
+#include "../include/datamember.h"
 #include "../include/argument.h"
 #include "../include/modifiers.h"
+#include "../include/hashmember.h"
+#include "../include/base.h"
+#include "../include/countable.h"
+#include "../include/arrayaccess.h"
+#include "../include/indexaccess.h"
+#include "../include/sortkey.h"
+#include "../include/sortable.h"
 #include "../include/classbase.h"
 #include "../include/interface.h"
 #include "../include/iterator.h"
+#include "../include/chunkediterator.h"
 #include "../include/traversable.h"
 #include "../include/serializable.h"
+#include "../include/encoder.h"
+#include "../include/decoder.h"
+#include "../include/streamserializable.h"
 #include "../include/class.h"
 #include "../include/namespace.h"
+#include "../include/moduleglobals.h"
+#include "../include/ini.h"
+#include "../include/cachestatistics.h"
+#include "../include/info.h"
+#include "../include/stream.h"
+#include "../include/streamwrapper.h"
 #include "../include/extension.h"
 
 /**
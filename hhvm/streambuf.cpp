@@ -16,26 +16,24 @@
 namespace Php {
 
 /**
- *  Called when the internal buffer should be synchronized
- *  @return int
+ *  Send data to PHP
+ *  @param  data
+ *  @param  size
  */
-int StreamBuf::sync()
+void StreamBuf::write(const char *data, size_t size)
 {
-    // current buffer size
-    size_t size = pptr() - pbase();
-    
     // is this the error stream or the regular output stream?
     if (_error)
     {
         // write to error (the zend_error() method is a varargs function, 
         // which means that we have to include a printf() like format as first
-        // parameter. We can not specify pbase() directly, because (1) it is
+        // parameter. We can not specify the data directly, because (1) it is
         // not null terminated and (2) it could contain % signs and allow all
         // sorts of buffer overflows.
         
         // @todo hhvm implementation
         
-//        zend_error(_error, "%.*s", (int)size, pbase());
+//        zend_error(_error, "%.*s", (int)size, data);
         
     }
     else
@@ -43,14 +41,8 @@ int StreamBuf::sync()
         // @todo hhvm implementation
         
         // write to zend
-//        zend_write(pbase(), size);
+//        zend_write(data, size);
     }
-    
-    // reset the buffer
-    pbump(-size);
-    
-    // done
-    return 0;
 }
 
 /**
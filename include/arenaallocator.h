@@ -0,0 +1,107 @@
+/**
+ *  ArenaAllocator.h
+ *
+ *  Allocator that can be used for standard containers, to store their 
+ *  elements in the request arena. Deallocating memory does nothing, the
+ *  memory is released when the request ends. The containers must therefore
+ *  not be used after the request is over.
+ *
+ *  std::vector<int, Php::ArenaAllocator<int>> numbers;
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Class definition
+ */
+template <typename T>
+class ArenaAllocator
+{
+public:
+    /**
+     *  Types that are required for an allocator
+     */
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    /**
+     *  The same allocator for a different type
+     */
+    template <typename X>
+    struct rebind { typedef ArenaAllocator<X> other; };
+
+    /**
+     *  Constructors
+     */
+    ArenaAllocator() {}
+    template <typename X>
+    ArenaAllocator(const ArenaAllocator<X> &that) {}
+
+    /**
+     *  Allocate memory for a number of objects
+     *  @param  count
+     *  @return T*
+     */
+    T *allocate(size_t count)
+    {
+        return RequestArena::allocate<T>(count);
+    }
+
+    /**
+     *  Deallocate memory, this does nothing
+     *  @param  pointer
+     *  @param  count
+     */
+    void deallocate(T *pointer, size_t count) {}
+
+    /**
+     *  Construct and destruct an object
+     *  @param  pointer
+     *  @param  args
+     */
+    template <typename X, typename... Args>
+    void construct(X *pointer, Args&&... args)
+    {
+        ::new((void *)pointer) X(std::forward<Args>(args)...);
+    }
+    template <typename X>
+    void destroy(X *pointer)
+    {
+        pointer->~X();
+    }
+
+    /**
+     *  Maximum number of objects that can be allocated
+     *  @return size_t
+     */
+    size_t max_size() const
+    {
+        return size_t(-1) / sizeof(T);
+    }
+
+    /**
+     *  All arena allocators are the same
+     *  @param  that
+     *  @return bool
+     */
+    template <typename X>
+    bool operator==(const ArenaAllocator<X> &that) const { return true; }
+    template <typename X>
+    bool operator!=(const ArenaAllocator<X> &that) const { return false; }
+};
+
+/**
+ *  End namespace
+ */
+}
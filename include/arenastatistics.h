@@ -0,0 +1,58 @@
+/**
+ *  ArenaStatistics.h
+ *
+ *  Counters that describe the memory usage of the request arena. You can
+ *  retrieve these counters with Php::RequestArena::statistics() to find out
+ *  how much memory the arena uses, and how much it used at most.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Class definition
+ */
+class ArenaStatistics
+{
+public:
+    /**
+     *  Number of bytes that were handed out during the current request
+     *  @var    size_t
+     */
+    size_t used = 0;
+
+    /**
+     *  Number of bytes that were reserved from the Zend engine during the
+     *  current request (this is the number that counts for the memory_limit)
+     *  @var    size_t
+     */
+    size_t reserved = 0;
+
+    /**
+     *  Number of blocks that were reserved during the current request
+     *  @var    size_t
+     */
+    size_t blocks = 0;
+
+    /**
+     *  Highest number of bytes that were handed out during a single request
+     *  @var    size_t
+     */
+    size_t peakUsed = 0;
+
+    /**
+     *  Highest number of bytes that were reserved during a single request
+     *  @var    size_t
+     */
+    size_t peakReserved = 0;
+};
+
+/**
+ *  End namespace
+ */
+}
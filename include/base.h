@@ -131,7 +131,17 @@ public:
      *  The default implementation does nothing
      */
     void __clone() const {}
-    
+
+    /**
+     *  Overridable method that is called when an object is put back in the
+     *  object pool of its class (see Php::Class::pool()). The next time that
+     *  an instance of the class is created, this object is handed out again,
+     *  so this is the place to clear the per-instance state.
+     *
+     *  The default implementation does nothing
+     */
+    void __reset() const {}
+
     /**
      *  Overridable method that is called to check if a property is set
      * 
@@ -0,0 +1,170 @@
+/**
+ *  BufferStream.h
+ *
+ *  Read-only stream over a block of memory. The memory is not copied: the
+ *  stream can refer to a buffer that is owned by someone else, or share the
+ *  ownership of a string that is kept in a cache or storage layer:
+ *
+ *      std::shared_ptr<const std::string> blob = storage.find(path);
+ *      return blob ? new Php::BufferStream(blob) : nullptr;
+ *
+ *  Because the contents are available in memory, PHP functions that copy
+ *  the stream can do so without any intermediate buffers.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Class definition
+ */
+class BufferStream : public Stream
+{
+public:
+    /**
+     *  Constructor for memory that is owned by the caller, and that must
+     *  remain valid for the lifetime of the stream
+     *  @param  data
+     *  @param  size
+     */
+    BufferStream(const char *data, size_t size) : _data(data), _size(size) {}
+
+    /**
+     *  Constructor for a string that is shared with the caller
+     *  @param  data        The string, this may not be a null pointer
+     */
+    BufferStream(const std::shared_ptr<const std::string> &data) : _shared(data)
+    {
+        // there must be a string to share
+        if (!data) throw Exception("BufferStream can not be constructed from a null pointer");
+
+        // expose the string
+        assign(data->data(), data->size());
+    }
+
+    /**
+     *  Constructor for a string that is handed over to the stream
+     *  @param  data
+     */
+    BufferStream(std::string &&data) : BufferStream(std::make_shared<const std::string>(std::move(data))) {}
+
+    /**
+     *  Destructor
+     */
+    virtual ~BufferStream() {}
+
+    /**
+     *  Read data from the stream
+     *  @param  buffer
+     *  @param  size
+     *  @return size_t
+     */
+    virtual size_t read(char *buffer, size_t size) override
+    {
+        // not more than what is left
+        if (size > _size - _position) size = _size - _position;
+
+        // copy the data
+        memcpy(buffer, _data + _position, size);
+
+        // move on
+        _position += size;
+        return size;
+    }
+
+    /**
+     *  Move to a different position
+     *  @param  offset
+     *  @param  whence
+     *  @return int64_t
+     */
+    virtual int64_t seek(int64_t offset, int whence) override
+    {
+        // the position to start from
+        int64_t start = whence == SEEK_CUR ? _position : whence == SEEK_END ? _size : 0;
+
+        // it is not possible to move outside the buffer
+        if (start + offset < 0 || start + offset > (int64_t)_size) return -1;
+
+        // store the new position
+        return _position = start + offset;
+    }
+
+    /**
+     *  Retrieve information about the stream
+     *  @param  stat
+     *  @return bool
+     */
+    virtual bool stat(StreamStat &stat) override
+    {
+        // the size is all we know
+        stat.size = _size;
+        return true;
+    }
+
+    /**
+     *  Retrieve the complete contents
+     *  @param  size
+     *  @return const char*
+     */
+    virtual const char *contents(size_t &size) override
+    {
+        // expose the buffer
+        size = _size;
+        return _data;
+    }
+
+protected:
+    /**
+     *  Constructor for derived classes that assign the memory later
+     */
+    BufferStream() {}
+
+    /**
+     *  Assign the memory
+     *  @param  data
+     *  @param  size
+     */
+    void assign(const char *data, size_t size)
+    {
+        // store the buffer
+        _data = data;
+        _size = size;
+    }
+
+private:
+    /**
+     *  The string that is shared with the caller
+     *  @var    std::shared_ptr
+     */
+    std::shared_ptr<const std::string> _shared;
+
+    /**
+     *  The memory
+     *  @var    const char *
+     */
+    const char *_data = nullptr;
+
+    /**
+     *  Size of the memory
+     *  @var    size_t
+     */
+    size_t _size = 0;
+
+    /**
+     *  The current position
+     *  @var    size_t
+     */
+    size_t _position = 0;
+};
+
+/**
+ *  End namespace
+ */
+}
+
@@ -0,0 +1,163 @@
+/**
+ *  Cache.h
+ *
+ *  A key/value cache that keeps its data alive across requests. A cache is
+ *  normally created as a static variable in the extension, and remains 
+ *  available for as long as the process runs. When the total size of the
+ *  entries exceeds the capacity of the cache, the least recently used
+ *  entries are removed.
+ *
+ *  PHP values (scalars, strings and nested arrays) are stored as a compact
+ *  copy that does not depend on the memory of a request. Every get() call 
+ *  creates a new Php::Value out of this copy. C++ objects can be stored too,
+ *  these are shared between all requests that fetch them, and must thus not
+ *  be modified.
+ *
+ *  The cache is divided into shards, that each have their own lock, so that
+ *  it can be used by multiple threads at the same time. The capacity is 
+ *  divided evenly over the shards, and every entry is stored in one shard,
+ *  so a single entry can not be bigger than the capacity divided by the 
+ *  number of shards (minus about 128 bytes of overhead and twice the size of
+ *  the key). A cache for big entries should therefore have fewer shards:
+ *
+ *      // room for entries of up to 16MB
+ *      static Php::Cache cache(64 * 1024 * 1024, 4);
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Forward declarations
+ */
+class CacheImpl;
+
+/**
+ *  Class definition
+ */
+class Cache
+{
+public:
+    /**
+     *  Constructor
+     *  @param  capacity    Max number of bytes to store
+     *  @param  shards      Number of independently locked parts
+     */
+    Cache(size_t capacity, size_t shards = 16);
+
+    /**
+     *  No copying or moving
+     *  @param  that
+     */
+    Cache(const Cache &that) = delete;
+    Cache(Cache &&that) = delete;
+
+    /**
+     *  Destructor
+     */
+    virtual ~Cache();
+
+    /**
+     *  Store a PHP value
+     *  @param  key         The key
+     *  @param  value       Value to store
+     *  @param  ttl         Time to live in seconds, zero for no expiration
+     *  @return bool        False if the value is bigger than a shard (see above), 
+     *                      an existing entry with the same key is then removed
+     */
+    bool set(const std::string &key, const Value &value, int ttl = 0);
+
+    /**
+     *  Retrieve a PHP value
+     *  @param  key         The key
+     *  @return Value       The value, or NULL if it was not found
+     */
+    Value get(const std::string &key);
+
+    /**
+     *  Store a C++ object
+     *  @param  key         The key
+     *  @param  object      The object to store
+     *  @param  size        The number of bytes that the object uses
+     *  @param  ttl         Time to live in seconds, zero for no expiration
+     *  @return bool        False if the object is bigger than a shard (see above),
+     *                      an existing entry with the same key is then removed
+     */
+    template <typename T>
+    bool setObject(const std::string &key, const std::shared_ptr<T> &object, size_t size, int ttl = 0)
+    {
+        return store(key, std::shared_ptr<const void>(object), typeid(T), size, ttl);
+    }
+
+    /**
+     *  Retrieve a C++ object
+     *  @param  key         The key
+     *  @return T           The object, or nullptr if it was not found or when it is of a different type
+     */
+    template <typename T>
+    std::shared_ptr<const T> getObject(const std::string &key)
+    {
+        return std::static_pointer_cast<const T>(fetch(key, typeid(T)));
+    }
+
+    /**
+     *  Check if an entry exists
+     *  @param  key         The key
+     *  @return bool
+     */
+    bool exists(const std::string &key);
+
+    /**
+     *  Remove an entry
+     *  @param  key         The key
+     *  @return bool        Was the entry found?
+     */
+    bool remove(const std::string &key);
+
+    /**
+     *  Remove all entries
+     */
+    void clear();
+
+    /**
+     *  Retrieve the counters of the cache
+     *  @return CacheStatistics
+     */
+    CacheStatistics statistics() const;
+
+private:
+    /**
+     *  The implementation
+     *  @var    CacheImpl
+     */
+    CacheImpl *_impl;
+
+    /**
+     *  Store an object
+     *  @param  key         The key
+     *  @param  object      The object to store
+     *  @param  type        Type of the object
+     *  @param  size        The number of bytes that the object uses
+     *  @param  ttl         Time to live in seconds
+     *  @return bool
+     */
+    bool store(const std::string &key, std::shared_ptr<const void> &&object, const std::type_info &type, size_t size, int ttl);
+
+    /**
+     *  Retrieve an object
+     *  @param  key         The key
+     *  @param  type        Expected type of the object
+     *  @return std::shared_ptr
+     */
+    std::shared_ptr<const void> fetch(const std::string &key, const std::type_info &type);
+};
+
+/**
+ *  End namespace
+ */
+}
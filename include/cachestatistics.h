@@ -0,0 +1,88 @@
+/**
+ *  CacheStatistics.h
+ *
+ *  Counters that describe how well a Php::Cache performs. The counters are
+ *  kept since the cache was created, and are shared by all requests that
+ *  are handled by the process.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Class definition
+ */
+class CacheStatistics
+{
+public:
+    /**
+     *  Max number of bytes that can be stored in the cache
+     *  @var    size_t
+     */
+    size_t capacity = 0;
+
+    /**
+     *  Number of bytes that are currently stored
+     *  @var    size_t
+     */
+    size_t bytes = 0;
+
+    /**
+     *  Number of entries that are currently stored
+     *  @var    size_t
+     */
+    size_t entries = 0;
+
+    /**
+     *  Number of lookups that found an entry
+     *  @var    size_t
+     */
+    size_t hits = 0;
+
+    /**
+     *  Number of lookups that did not find an entry
+     *  @var    size_t
+     */
+    size_t misses = 0;
+
+    /**
+     *  Number of entries that were stored
+     *  @var    size_t
+     */
+    size_t insertions = 0;
+
+    /**
+     *  Number of entries that were removed to make room for new entries
+     *  @var    size_t
+     */
+    size_t evictions = 0;
+
+    /**
+     *  Number of entries that were removed because their time to live expired
+     *  @var    size_t
+     */
+    size_t expirations = 0;
+
+    /**
+     *  The fraction of lookups that found an entry
+     *  @return double
+     */
+    double hitRate() const
+    {
+        // prevent division by zero
+        if (hits + misses == 0) return 0.0;
+
+        // calculate the rate
+        return (double)hits / (hits + misses);
+    }
+};
+
+/**
+ *  End namespace
+ */
+}
@@ -0,0 +1,237 @@
+/**
+ *  ChunkedIterator.h
+ *
+ *  Alternative base class for iterators. Instead of implementing the valid(),
+ *  current(), key() and next() methods that are called for every single
+ *  element, a derived class implements a fetch() method that fills a whole
+ *  block of values (and keys) at once. When a PHP foreach loop iterates over
+ *  such an iterator, the elements are taken directly from this block.
+ *
+ *  Iterators over a collection that has sequential integer keys (like a
+ *  vector) can pass "sequential" to the constructor. The fetch() method does
+ *  then not have to fill in any keys, because the position of each element
+ *  is used as its key.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Class definition
+ */
+class ChunkedIterator : public Iterator
+{
+public:
+    /**
+     *  Constructor
+     *  @param  base        Class over which the iterator is iterating
+     *  @param  sequential  Are the keys sequential integers, starting at zero?
+     *  @param  size        Number of elements to fetch at once
+     */
+    ChunkedIterator(Base *base, bool sequential = false, size_t size = 64) : 
+        Iterator(base), _values(size), _keys(sequential ? 0 : size), _sequential(sequential) {}
+    
+    /**
+     *  Destructor
+     */
+    virtual ~ChunkedIterator() {}
+    
+    /**
+     *  Fetch the next block of elements
+     * 
+     *  The method should assign at most "count" values, and the same number
+     *  of keys (unless the iterator is sequential, in which case the keys 
+     *  parameter is a nullptr). The method should return the number of
+     *  elements that were assigned, zero means that the end was reached.
+     * 
+     *  @param  values      Array of values to fill
+     *  @param  keys        Array of keys to fill, or nullptr
+     *  @param  count       Size of the arrays
+     *  @return size_t      Number of elements that were fetched
+     */
+    virtual size_t fetch(Value *values, Value *keys, size_t count) = 0;
+    
+    /**
+     *  Reset the iterator, so that the next call to fetch() returns the 
+     *  first block of elements again
+     */
+    virtual void reset() = 0;
+    
+    /**
+     *  Are the keys sequential integers?
+     *  @return bool
+     */
+    bool sequential() const
+    {
+        return _sequential;
+    }
+    
+    /**
+     *  Is the iterator on a valid position
+     *  @return bool
+     */
+    virtual bool valid() override final
+    {
+        // is there an element in the buffer, or can the buffer be filled?
+        return _pos < _count || fill();
+    }
+    
+    /**
+     *  The value at the current position
+     *  @return Value
+     */
+    virtual Value current() override final
+    {
+        // return the value from the buffer
+        return valid() ? _values[_pos] : Value(nullptr);
+    }
+    
+    /**
+     *  The key at the current position
+     *  @return Value
+     */
+    virtual Value key() override final
+    {
+        // check if the position is valid
+        if (!valid()) return nullptr;
+        
+        // sequential keys are not stored
+        return _sequential ? Value(position()) : _keys[_pos];
+    }
+    
+    /**
+     *  Move to the next position
+     */
+    virtual void next() override final
+    {
+        // move forward in the buffer
+        if (_pos < _count) _pos++;
+    }
+    
+    /**
+     *  Rewind the iterator to the front position
+     */
+    virtual void rewind() override final
+    {
+        // forget the buffered elements
+        _offset = _pos = _count = 0;
+        
+        // we may fetch again
+        _done = false;
+        
+        // pass on to the implementation
+        reset();
+    }
+
+private:
+    /**
+     *  Buffer with values
+     *  @var    std::vector
+     */
+    std::vector<Value> _values;
+    
+    /**
+     *  Buffer with keys (empty for sequential iterators)
+     *  @var    std::vector
+     */
+    std::vector<Value> _keys;
+    
+    /**
+     *  Are the keys sequential integers?
+     *  @var    bool
+     */
+    bool _sequential;
+    
+    /**
+     *  Position of the first buffered element in the whole collection
+     *  @var    int64_t
+     */
+    int64_t _offset = 0;
+    
+    /**
+     *  Current position in the buffer
+     *  @var    size_t
+     */
+    size_t _pos = 0;
+    
+    /**
+     *  Number of elements in the buffer
+     *  @var    size_t
+     */
+    size_t _count = 0;
+    
+    /**
+     *  Has the end been reached?
+     *  @var    bool
+     */
+    bool _done = false;
+    
+    /**
+     *  Fill the buffer with the next block of elements
+     *  @return bool        Are there elements in the buffer?
+     */
+    bool fill()
+    {
+        // if the end was already reached we do not fetch again
+        if (_done) return false;
+        
+        // the elements that were already consumed
+        _offset += _count;
+        _pos = 0;
+        
+        // fetch the next block
+        _count = fetch(_values.data(), _sequential ? nullptr : _keys.data(), _values.size());
+        
+        // protect against implementations that return too much
+        if (_count > _values.size()) _count = _values.size();
+        
+        // was the end reached?
+        if (_count == 0) _done = true;
+        
+        // done
+        return _count > 0;
+    }
+    
+    /**
+     *  Position of the current element in the whole collection
+     *  @return int64_t
+     */
+    int64_t position() const
+    {
+        return _offset + _pos;
+    }
+    
+    /**
+     *  Reference to the current value, to be used when the iterator is
+     *  known to be on a valid position
+     *  @return Value
+     */
+    Value &value()
+    {
+        return _values[_pos];
+    }
+    
+    /**
+     *  Reference to the current key, only for iterators that are not sequential
+     *  @return Value
+     */
+    Value &index()
+    {
+        return _keys[_pos];
+    }
+    
+    /**
+     *  The iterator implementation may access the buffers directly
+     */
+    friend class IteratorImpl;
+};
+    
+/**
+ *  End namespace
+ */
+}
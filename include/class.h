@@ -128,6 +128,23 @@ public:
     Class<T> &method(const char *name, int flags, const Arguments &args = {}) { ClassBase::method(name, flags  | Abstract, args); return *this; }
     Class<T> &method(const char *name,            const Arguments &args = {}) { ClassBase::method(name, Public | Abstract, args); return *this; }
 
+    /**
+     *  Add a method that is implemented by __call() or __callStatic()
+     * 
+     *  If your class implements __call() or __callStatic(), every call to an 
+     *  undefined method first has to go through a failed method lookup, after
+     *  which a function record is set up that forwards the call to the magic
+     *  method. If you already know which method names will be called, you can 
+     *  register these names up front. They then become real methods of the 
+     *  class that directly call __call() (or __callStatic(), when the 
+     *  Php::Static flag is set), with the registered name as method name.
+     * 
+     *  @param  name        Name of the method
+     *  @param  flags       Optional flags
+     *  @return Class       Same object to allow chaining
+     */
+    Class<T> &dynamicMethod(const char *name, int flags = Public) { ClassBase::dynamicMethod(name, flags); return *this; }
+
     /**
      *  Add a property to the class
      * 
@@ -172,6 +189,21 @@ public:
     Class<T> &property(const char *name, Value (T::*getter)()      , void (T::*setter)(const Value &value) const) { ClassBase::property(name, static_cast<getter_callback_0>(getter), static_cast<setter_callback_1>(setter)); return *this; }
     Class<T> &property(const char *name, Value (T::*getter)() const, void (T::*setter)(const Value &value) const) { ClassBase::property(name, static_cast<getter_callback_1>(getter), static_cast<setter_callback_1>(setter)); return *this; }
 
+    /**
+     *  Properties as data members
+     * 
+     *  The property is directly linked to a member variable of the C++ object,
+     *  and the member is converted from and to a PHP variable every time the
+     *  property is read or written. Members of an arithmetic type, bools and
+     *  std::string members are supported. Const members are read-only.
+     * 
+     *  @param  name        Name of the property
+     *  @param  member      Pointer to the data member
+     */
+    template <typename X>
+    typename std::enable_if<!std::is_function<X>::value, Class<T>&>::type
+    property(const char *name, X T::*member) { ClassBase::property(name, std::make_shared<BoundMember<T,X>>(member)); return *this; }
+
     /**
      *  Add a PHP interface to the class
      * 
@@ -199,7 +231,33 @@ public:
      */
     template<typename CLASS>
     Class<T> &extends(const Class<CLASS> &base) { ClassBase::extends(base); return *this; }
-    
+
+    /**
+     *  Enable recycling of objects
+     *
+     *  When a PHP script creates and destroys many short-lived instances of
+     *  a class, allocating and deallocating both the C++ object and the Zend
+     *  object becomes expensive. If you enable the pool, objects that are
+     *  destructed are not deallocated, but kept in a per-class pool and handed
+     *  out again the next time an instance is created. Right before an object
+     *  is put in the pool, its __reset() method is called (so if your class has
+     *  state, you should implement __reset() to clear it). The constructor of
+     *  a recycled object is not called again.
+     *
+     *  The pool is emptied at the end of every request. On thread safe builds
+     *  of PHP the pool is not used.
+     *
+     *  @param  capacity    Max number of idle objects kept in the pool
+     *  @return Class       Same object to allow chaining
+     */
+    Class<T> &pool(size_t capacity) { ClassBase::pool(capacity); return *this; }
+
+    /**
+     *  Retrieve the counters of the object pool
+     *  @return PoolStatistics
+     */
+    PoolStatistics statistics() const { return ClassBase::statistics(); }
+
 private:
     /**
      *  Construct a new instance of the object
@@ -277,6 +335,115 @@ private:
         return std::is_base_of<Serializable,T>::value;
     }
 
+    /**
+     *  Is this a class that serializes with an encoder and decoder?
+     *  @return bool
+     */
+    virtual bool streamSerializable() const override
+    {
+        // check if the templated class overrides from the StreamSerializable class
+        return std::is_base_of<StreamSerializable,T>::value;
+    }
+
+    /**
+     *  Does this class implement the Countable interface?
+     *  @return bool
+     */
+    virtual bool countable() const override
+    {
+        // check if the templated class overrides from the Countable class
+        return std::is_base_of<Countable,T>::value;
+    }
+
+    /**
+     *  Does this class implement the ArrayAccess interface?
+     *  @return bool
+     */
+    virtual bool arrayAccess() const override
+    {
+        // check if the templated class overrides from the ArrayAccess class
+        return std::is_base_of<ArrayAccess,T>::value;
+    }
+
+    /**
+     *  Does this class implement the IndexAccess interface?
+     *  @return bool
+     */
+    virtual bool indexAccess() const override
+    {
+        // check if the templated class overrides from the IndexAccess class
+        return std::is_base_of<IndexAccess,T>::value;
+    }
+
+    /**
+     *  Does this class implement the Sortable interface?
+     *  @return bool
+     */
+    virtual bool sortable() const override
+    {
+        // check if the templated class overrides from the Sortable class
+        return std::is_base_of<Sortable,T>::value;
+    }
+
+    /**
+     *  Calculate the location of an interface inside the object, relative to
+     *  the Base class, for classes that implement the interface
+     *  @return std::ptrdiff_t
+     */
+    template <typename I, typename X = T>
+    typename std::enable_if<std::is_base_of<I,X>::value, std::ptrdiff_t>::type
+    static offset()
+    {
+        // with virtual inheritance the location of a base class is only known 
+        // at runtime, and differs from object to object
+        static_assert(!virtualBase<I,X>(nullptr), "Interfaces may not be virtual base classes");
+        static_assert(!virtualBase<Base,X>(nullptr), "Php::Base may not be a virtual base class");
+
+        // the calculation needs the address of an object, but without virtual
+        // bases the casts do not access it, so memory of the right size and
+        // alignment is enough (a cast from a null pointer results in null)
+        static typename std::aligned_storage<sizeof(X), alignof(X)>::type storage;
+        X *object = reinterpret_cast<X*>(&storage);
+        
+        // the distance between the two base classes
+        return reinterpret_cast<char*>(static_cast<I*>(object)) - reinterpret_cast<char*>(static_cast<Base*>(object));
+    }
+
+    /**
+     *  Check whether a class is a virtual base class, a pointer to a member
+     *  of a virtual base can not be converted to a pointer to a member of 
+     *  the derived class, so the first function is then not a candidate
+     *  @return bool
+     */
+    template <typename B, typename X>
+    static constexpr bool virtualBase(decltype(static_cast<char X::*>((char B::*)nullptr))) { return false; }
+    template <typename B, typename X>
+    static constexpr bool virtualBase(...) { return true; }
+
+    /**
+     *  Calculate the location of an interface that is not implemented
+     *  @return std::ptrdiff_t
+     */
+    template <typename I, typename X = T>
+    typename std::enable_if<!std::is_base_of<I,X>::value, std::ptrdiff_t>::type
+    static offset()
+    {
+        // not implemented, the offset is never used
+        return 0;
+    }
+
+    /**
+     *  Location of the interfaces inside the object
+     *  @return std::ptrdiff_t
+     */
+    virtual std::ptrdiff_t traversableOffset()  const override { return offset<Traversable>(); }
+    virtual std::ptrdiff_t serializableOffset() const override { return offset<Serializable>(); }
+    virtual std::ptrdiff_t streamSerializableOffset() const override { return offset<StreamSerializable>(); }
+    virtual std::ptrdiff_t countableOffset()    const override { return offset<Countable>(); }
+    virtual std::ptrdiff_t arrayAccessOffset()  const override { return offset<ArrayAccess>(); }
+    virtual std::ptrdiff_t indexAccessOffset()  const override { return offset<IndexAccess>(); }
+    virtual std::ptrdiff_t sortableOffset()     const override { return offset<Sortable>(); }
+
     /**
      *  Call the __clone method
      *  @param  base
@@ -290,6 +457,17 @@ private:
         return object->__clone();
     }
 
+    /**
+     *  Does the class have its own __clone method? If it does not, the empty
+     *  method of the Base class does not have to be called
+     *  @return bool
+     */
+    virtual bool cloneMethod() const override
+    {
+        // the method pointer has a different type if it was not inherited
+        return !std::is_same<decltype(&T::__clone), decltype(&Base::__clone)>::value;
+    }
+
     /**
      *  Call the __destruct method
      *  @param  base
@@ -303,6 +481,19 @@ private:
         return object->__destruct();
     }
 
+    /**
+     *  Call the __reset method
+     *  @param  base
+     */
+    virtual void callReset(Base *base) const override
+    {
+        // cast to the user object
+        T *object = (T *)base;
+
+        // call the method on the base object
+        return object->__reset();
+    }
+
     /**
      *  Call a method
      *  @param  base        Object to call on
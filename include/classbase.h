@@ -106,8 +106,26 @@ public:
      */
     virtual bool traversable()  const { return false; }
     virtual bool serializable() const { return false; }
+    virtual bool streamSerializable() const { return false; }
+    virtual bool countable()    const { return false; }
+    virtual bool arrayAccess()  const { return false; }
+    virtual bool indexAccess()  const { return false; }
+    virtual bool sortable()     const { return false; }
     virtual bool clonable()     const { return false; }
 
+    /**
+     *  Location of the interfaces inside the object, relative to the Base
+     *  class. The offsets are only meaningful if the interface is implemented
+     *  @return std::ptrdiff_t
+     */
+    virtual std::ptrdiff_t traversableOffset()  const { return 0; }
+    virtual std::ptrdiff_t serializableOffset() const { return 0; }
+    virtual std::ptrdiff_t streamSerializableOffset() const { return 0; }
+    virtual std::ptrdiff_t countableOffset()    const { return 0; }
+    virtual std::ptrdiff_t arrayAccessOffset()  const { return 0; }
+    virtual std::ptrdiff_t indexAccessOffset()  const { return 0; }
+    virtual std::ptrdiff_t sortableOffset()     const { return 0; }
+
     /**
      *  Compare two objects
      *  @param  object1
@@ -122,7 +140,19 @@ public:
      */
     virtual void callClone(Base *base) const {}
     virtual void callDestruct(Base *base) const {}
-    
+
+    /**
+     *  Does the class have its own __clone method?
+     *  @return bool
+     */
+    virtual bool cloneMethod() const { return false; }
+
+    /**
+     *  Call the __reset method, right before an object is put in the object pool
+     *  @param  base
+     */
+    virtual void callReset(Base *base) const {}
+
     /**
      *  Call the __call(), __invoke() or __callStatic() method
      *  @param  base        Object to call on
@@ -219,6 +249,13 @@ protected:
      */
     void method(const char *name, int flags=0, const Arguments &args = {});
 
+    /**
+     *  Add a method that is implemented by the __call() or __callStatic() method
+     *  @param  name        Name of the method
+     *  @param  flags       Optional flags (Php::Static for __callStatic())
+     */
+    void dynamicMethod(const char *name, int flags=0);
+
     /**
      *  Add a property to the class
      * 
@@ -255,6 +292,13 @@ protected:
     void property(const char *name, const getter_callback_0 &getter, const setter_callback_1 &setter);
     void property(const char *name, const getter_callback_1 &getter, const setter_callback_1 &setter);
 
+    /**
+     *  Set property that is bound to a data member
+     *  @param  name        Name of the property
+     *  @param  member      The data member
+     */
+    void property(const char *name, const std::shared_ptr<DataMember> &member);
+
     /**
      *  Add an interface
      *  @param  interface       Interface object
@@ -267,6 +311,18 @@ protected:
      */
     void extends(const ClassBase &base);
 
+    /**
+     *  Enable the object pool
+     *  @param  capacity        Max number of idle objects to keep
+     */
+    void pool(size_t capacity);
+
+    /**
+     *  Retrieve the counters of the object pool
+     *  @return PoolStatistics
+     */
+    PoolStatistics statistics() const;
+
 private:
     /**
      *  Pointer to the actual implementation
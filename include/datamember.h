@@ -0,0 +1,172 @@
+/**
+ *  DataMember.h
+ *
+ *  When a C++ data member is registered as a PHP property (for example with
+ *  Php::Class<Point>::property("x", &Point::x)), the PHP-CPP library needs
+ *  to be able to find the address of that member in an object, and needs
+ *  to know its type to convert it from and to a PHP variable. This is an
+ *  internal class that holds this information.
+ *
+ *  Arithmetic types, bools and std::string members are supported.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Forward declarations
+ */
+class Base;
+
+/**
+ *  Class definition
+ */
+class DataMember
+{
+protected:
+    /**
+     *  Constructor
+     *  @param  type        Type of the member (numeric, float, bool or string)
+     *  @param  size        Size of the member in bytes
+     *  @param  isSigned    Is it a signed numeric type?
+     *  @param  readOnly    Is it a const member?
+     */
+    DataMember(Type type, size_t size, bool isSigned, bool readOnly) :
+        _type(type), _size(size), _signed(isSigned), _readOnly(readOnly) {}
+
+public:
+    /**
+     *  Destructor
+     */
+    virtual ~DataMember() {}
+
+    /**
+     *  Retrieve the address of the member inside an object
+     *  @param  base        The object
+     *  @return void*
+     */
+    virtual void *pointer(Base *base) const = 0;
+
+    /**
+     *  Type of the member
+     *  @return Type
+     */
+    Type type() const { return _type; }
+
+    /**
+     *  Size of the member in bytes
+     *  @return size_t
+     */
+    size_t size() const { return _size; }
+
+    /**
+     *  Is this a signed numeric member?
+     *  @return bool
+     */
+    bool isSigned() const { return _signed; }
+
+    /**
+     *  Is this a const member that can not be assigned from PHP?
+     *  @return bool
+     */
+    bool readOnly() const { return _readOnly; }
+
+private:
+    /**
+     *  Type of the member
+     *  @var    Type
+     */
+    Type _type;
+
+    /**
+     *  Size of the member
+     *  @var    size_t
+     */
+    size_t _size;
+
+    /**
+     *  Is it a signed type?
+     *  @var    bool
+     */
+    bool _signed;
+
+    /**
+     *  Is it a const member?
+     *  @var    bool
+     */
+    bool _readOnly;
+};
+
+/**
+ *  Implementation for a specific member of a specific class
+ */
+template <typename T, typename X>
+class BoundMember : public DataMember
+{
+private:
+    /**
+     *  The member pointer
+     *  @var    X T::*
+     */
+    X T::*_member;
+
+    /**
+     *  The type of the member without a const qualifier
+     */
+    typedef typename std::remove_const<X>::type Plain;
+
+    /**
+     *  Make sure that only supported types are bound
+     */
+    static_assert(std::is_arithmetic<Plain>::value || std::is_same<Plain,std::string>::value, "Only arithmetic, bool and std::string members can be bound to a property");
+
+    /**
+     *  Find out the type of the member
+     *  @return Type
+     */
+    static Type memberType()
+    {
+        if (std::is_same<Plain,bool>::value) return Type::Bool;
+        if (std::is_integral<Plain>::value) return Type::Numeric;
+        if (std::is_floating_point<Plain>::value) return Type::Float;
+        return Type::String;
+    }
+
+public:
+    /**
+     *  Constructor
+     *  @param  member      The member pointer
+     */
+    BoundMember(X T::*member) :
+        DataMember(memberType(), sizeof(X), std::is_signed<Plain>::value, std::is_const<X>::value), _member(member) {}
+
+    /**
+     *  Destructor
+     */
+    virtual ~BoundMember() {}
+
+    /**
+     *  Retrieve the address of the member inside an object
+     *  @param  base        The object
+     *  @return void*
+     */
+    virtual void *pointer(Base *base) const override
+    {
+        // cast to the user object
+        T *object = (T *)base;
+
+        // address of the member
+        return (void *)&(object->*_member);
+    }
+};
+
+/**
+ *  End namespace
+ */
+}
+
@@ -0,0 +1,222 @@
+/**
+ *  Decoder.h
+ *
+ *  Class that is passed to the unserialize() method of a StreamSerializable
+ *  object. It is a cursor over the data that was earlier written with the
+ *  Encoder class. The data must be read back in the same order as it was
+ *  written. If the data runs out, or if it is corrupt, a Php::Exception is
+ *  thrown.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Class definition
+ */
+class Decoder
+{
+public:
+    /**
+     *  Constructor
+     *  @param  data        The data to read
+     *  @param  size        Size of the data
+     */
+    Decoder(const char *data, size_t size) : _data(data), _size(size) {}
+
+    /**
+     *  Destructor
+     */
+    virtual ~Decoder() {}
+
+    /**
+     *  Read a signed integer
+     *  @return int64_t
+     */
+    int64_t readInteger()
+    {
+        // undo the zigzag encoding
+        uint64_t value = readUnsigned();
+        return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+    }
+
+    /**
+     *  Read an unsigned integer
+     *  @return uint64_t
+     */
+    uint64_t readUnsigned()
+    {
+        // the result
+        uint64_t result = 0;
+
+        // seven bits per byte, the high bit is set when more bytes follow
+        for (int shift = 0; shift < 64; shift += 7)
+        {
+            // next byte
+            unsigned char byte = readByte();
+
+            // add the bits
+            result |= (uint64_t)(byte & 0x7f) << shift;
+
+            // was this the last byte?
+            if (!(byte & 0x80)) return result;
+        }
+
+        // too many bytes
+        throw Exception("Corrupt integer in serialized data");
+    }
+
+    /**
+     *  Read a floating point number
+     *  @return double
+     */
+    double readDouble()
+    {
+        // the eight bytes, in little endian order
+        const unsigned char *bytes = (const unsigned char *)readRaw(8);
+
+        // combine the bytes
+        uint64_t bits = 0;
+        for (int i = 0; i < 8; i++) bits |= (uint64_t)bytes[i] << (8 * i);
+
+        // turn into a double
+        double result;
+        memcpy(&result, &bits, sizeof(result));
+        return result;
+    }
+
+    /**
+     *  Read a boolean
+     *  @return bool
+     */
+    bool readBool()
+    {
+        return readByte() != 0;
+    }
+
+    /**
+     *  Read a string
+     *  @return std::string
+     */
+    std::string readString()
+    {
+        // the size comes first
+        size_t size = readUnsigned();
+
+        // construct the string
+        return std::string(readRaw(size), size);
+    }
+
+    /**
+     *  Read a string without copying it
+     *
+     *  The returned pointer points into the serialized data, and is not
+     *  null terminated. It is only valid during the unserialize() call.
+     *
+     *  @param  size        Will be filled with the size of the string
+     *  @return const char *
+     */
+    const char *readString(size_t &size)
+    {
+        // the size comes first
+        size = readUnsigned();
+
+        // pointer to the data
+        return readRaw(size);
+    }
+
+    /**
+     *  Read raw bytes that were written with Encoder::writeRaw()
+     *  @param  size        Number of bytes
+     *  @return const char *
+     */
+    const char *readRaw(size_t size)
+    {
+        // check the size
+        if (size > remaining()) throw Exception("Unexpected end of serialized data");
+
+        // move the cursor
+        const char *result = _data + _pos;
+        _pos += size;
+
+        // done
+        return result;
+    }
+
+    /**
+     *  Read a PHP value that was written with Encoder::writeValue()
+     *  @return Value
+     */
+    Value readValue()
+    {
+        return readValue(0);
+    }
+
+    /**
+     *  Number of bytes that have not yet been read
+     *  @return size_t
+     */
+    size_t remaining() const
+    {
+        return _size - _pos;
+    }
+
+    /**
+     *  Has all data been read?
+     *  @return bool
+     */
+    bool eof() const
+    {
+        return _pos >= _size;
+    }
+
+private:
+    /**
+     *  The data
+     *  @var    const char *
+     */
+    const char *_data;
+
+    /**
+     *  Size of the data
+     *  @var    size_t
+     */
+    size_t _size;
+
+    /**
+     *  Current position
+     *  @var    size_t
+     */
+    size_t _pos = 0;
+
+    /**
+     *  Read a single byte
+     *  @return unsigned char
+     */
+    unsigned char readByte()
+    {
+        // check if there is data left
+        if (_pos >= _size) throw Exception("Unexpected end of serialized data");
+
+        // read the byte
+        return (unsigned char)_data[_pos++];
+    }
+
+    /**
+     *  Read a PHP value
+     *  @param  depth       Current nesting level of arrays
+     *  @return Value
+     */
+    Value readValue(int depth);
+};
+
+/**
+ *  End namespace
+ */
+}
+
@@ -0,0 +1,250 @@
+/**
+ *  Encoder.h
+ *
+ *  Class that is passed to the serialize() method of a StreamSerializable
+ *  object. The object writes its state into the encoder, which stores it in
+ *  a compact binary format in a buffer that is directly handed over to the
+ *  Zend engine, so that no copies of the data have to be made.
+ *
+ *  Integers are stored as variable length integers (small numbers only take
+ *  one byte), doubles take eight bytes, and strings are prefixed with their
+ *  size. The data can be read back with the Decoder class, in exactly the same
+ *  order as it was written.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Class definition
+ */
+class Encoder
+{
+public:
+    /**
+     *  Constructor
+     */
+    Encoder() {}
+
+    /**
+     *  No copying, the buffer can only have one owner
+     *  @param  that
+     */
+    Encoder(const Encoder &that) = delete;
+
+    /**
+     *  Destructor
+     */
+    virtual ~Encoder();
+
+    /**
+     *  Write a signed integer
+     *  @param  value
+     *  @return Encoder
+     */
+    Encoder &writeInteger(int64_t value)
+    {
+        // zigzag encoding, so that small negative numbers are small too
+        return writeUnsigned(((uint64_t)value << 1) ^ (uint64_t)(value >> 63));
+    }
+
+    /**
+     *  Write an unsigned integer
+     *  @param  value
+     *  @return Encoder
+     */
+    Encoder &writeUnsigned(uint64_t value)
+    {
+        // a 64 bit number takes at most ten bytes
+        reserve(10);
+
+        // seven bits per byte, the high bit is set when more bytes follow
+        while (value >= 0x80)
+        {
+            _buffer[_size++] = (char)(value | 0x80);
+            value >>= 7;
+        }
+
+        // last byte
+        _buffer[_size++] = (char)value;
+
+        // allow chaining
+        return *this;
+    }
+
+    /**
+     *  Write a floating point number
+     *  @param  value
+     *  @return Encoder
+     */
+    Encoder &writeDouble(double value)
+    {
+        // the bytes of the number
+        uint64_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+
+        // we need eight bytes
+        reserve(8);
+
+        // store in little endian order
+        for (int i = 0; i < 8; i++) _buffer[_size++] = (char)(bits >> (8 * i));
+
+        // allow chaining
+        return *this;
+    }
+
+    /**
+     *  Write a boolean
+     *  @param  value
+     *  @return Encoder
+     */
+    Encoder &writeBool(bool value)
+    {
+        // one byte
+        reserve(1);
+        _buffer[_size++] = value ? 1 : 0;
+
+        // allow chaining
+        return *this;
+    }
+
+    /**
+     *  Write a string
+     *  @param  value       The string data
+     *  @param  size        Size of the string
+     *  @return Encoder
+     */
+    Encoder &writeString(const char *value, size_t size)
+    {
+        // the size goes first, then the data
+        writeUnsigned(size);
+        return writeRaw(value, size);
+    }
+
+    /**
+     *  Write a string
+     *  @param  value
+     *  @return Encoder
+     */
+    Encoder &writeString(const std::string &value)
+    {
+        return writeString(value.data(), value.size());
+    }
+
+    /**
+     *  Write raw bytes, without a size prefix
+     *  @param  data        The data
+     *  @param  size        Size of the data
+     *  @return Encoder
+     */
+    Encoder &writeRaw(const char *data, size_t size)
+    {
+        // make sure there is enough room
+        reserve(size);
+
+        // copy the data
+        memcpy(_buffer + _size, data, size);
+        _size += size;
+
+        // allow chaining
+        return *this;
+    }
+
+    /**
+     *  Write a PHP value
+     *
+     *  Scalars and (nested) arrays are encoded in the binary format, objects
+     *  are encoded with the PHP serialize() function. Arrays that are nested
+     *  deeper than the Decoder accepts (which includes arrays that contain
+     *  a reference to themselves) throw an exception.
+     *
+     *  @param  value
+     *  @return Encoder
+     */
+    Encoder &writeValue(const Value &value)
+    {
+        return writeValue(value, 0);
+    }
+
+    /**
+     *  Number of bytes that have been written
+     *  @return size_t
+     */
+    size_t size() const
+    {
+        return _size;
+    }
+
+    /**
+     *  The data that has been written
+     *  @return const char *
+     */
+    const char *data() const
+    {
+        return _buffer;
+    }
+
+    /**
+     *  Hand over the buffer to the caller
+     *
+     *  The buffer is allocated by the Zend engine, the caller becomes
+     *  responsible for freeing it, and the encoder is empty afterwards
+     *
+     *  @return char*
+     */
+    char *release();
+
+private:
+    /**
+     *  Write a PHP value
+     *  @param  value
+     *  @param  depth       Current nesting level of arrays
+     *  @return Encoder
+     */
+    Encoder &writeValue(const Value &value, int depth);
+
+    /**
+     *  The buffer (allocated by the Zend engine)
+     *  @var    char*
+     */
+    char *_buffer = nullptr;
+
+    /**
+     *  Number of bytes in use
+     *  @var    size_t
+     */
+    size_t _size = 0;
+
+    /**
+     *  Number of bytes allocated
+     *  @var    size_t
+     */
+    size_t _capacity = 0;
+
+    /**
+     *  Make sure there is room for a number of extra bytes
+     *  @param  size        Number of bytes that are going to be written
+     */
+    void reserve(size_t size)
+    {
+        // is there enough room?
+        if (_size + size > _capacity) grow(size);
+    }
+
+    /**
+     *  Grow the buffer
+     *  @param  size        Number of bytes that are going to be written
+     */
+    void grow(size_t size);
+};
+
+/**
+ *  End namespace
+ */
+}
+
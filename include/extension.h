@@ -104,6 +104,58 @@ public:
      */
     Extension &onIdle(const Callback &callback);
     
+    /**
+     *  Register a callback that adds rows to the phpinfo() output
+     * 
+     *  The section of the extension in the phpinfo() output already shows
+     *  the registered functions and classes, and the number of live objects.
+     *  The callback can add rows with information about the extension itself.
+     * 
+     *  @param  callback    Function to be called
+     *  @return Extension   Same object to allow chaining
+     */
+    Extension &onInfo(const InfoCallback &callback);
+    
+    /**
+     *  Count the calls to the functions of the extension
+     * 
+     *  The counters are shown in the phpinfo() output. This must be called
+     *  before the extension is started, and costs one atomic increment
+     *  per call.
+     * 
+     *  @param  enabled     Should the calls be counted?
+     *  @return Extension   Same object to allow chaining
+     */
+    Extension &instrument(bool enabled = true);
+    
+    /**
+     *  Add a php.ini setting to the extension
+     * 
+     *  The setting is registered when the extension is started, and the
+     *  variable that is bound to it is updated when the setting changes.
+     * 
+     *  @param  ini         The setting
+     *  @return Extension   Same object to allow chaining
+     */
+    Extension &add(Ini &&ini);
+    Extension &add(const Ini &ini);
+    
+    /**
+     *  Add a stream wrapper to the extension
+     * 
+     *  The wrapper is registered when the extension is started, and from
+     *  then on handles all urls that start with its protocol.
+     * 
+     *  @param  wrapper     The wrapper
+     *  @return Extension   Same object to allow chaining
+     */
+    Extension &add(const std::shared_ptr<StreamWrapper> &wrapper);
+    
+    /**
+     *  The methods to add functions, classes and namespaces
+     */
+    using Namespace::add;
+    
     /**
      *  Retrieve the module pointer
      * 
@@ -0,0 +1,71 @@
+/**
+ *  IndexAccess.h
+ *
+ *  Interface for list-like classes that can be accessed with integer offsets,
+ *  like $object[3]. It is an alternative for the ArrayAccess interface: the
+ *  offsets are passed as plain integers, so that they do not have to be
+ *  wrapped in Php::Value objects.
+ *
+ *  Offsets that are not integers, but that can be converted to one (like
+ *  floats and numeric strings) are converted. If the class also implements
+ *  the ArrayAccess interface, those offsets are passed to that interface 
+ *  instead.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+    
+/**
+ *  Class definition
+ */
+class IndexAccess
+{
+public:
+    /**
+     *  Check if an element exists
+     *  @param  index
+     *  @return bool
+     */
+    virtual bool indexExists(int64_t index) = 0;
+    
+    /**
+     *  Retrieve an element
+     *  @param  index
+     *  @return Value
+     */
+    virtual Php::Value indexGet(int64_t index) = 0;
+    
+    /**
+     *  Set an element
+     *  @param  index
+     *  @param  value
+     */
+    virtual void indexSet(int64_t index, const Php::Value &value) = 0;
+    
+    /**
+     *  Remove an element
+     *  @param  index
+     */
+    virtual void indexUnset(int64_t index) = 0;
+
+    /**
+     *  Add an element to the end, this is called for $object[] = $value
+     *  @param  value
+     */
+    virtual void indexAppend(const Php::Value &value)
+    {
+        // not supported by default
+        throw Exception("[] operator not supported for this object");
+    }
+};
+    
+/**
+ *  End namespace
+ */
+}
+
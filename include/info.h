@@ -0,0 +1,86 @@
+/**
+ *  Info.h
+ *
+ *  Every extension gets a section in the output of phpinfo(), that shows
+ *  the registered functions and classes, the number of live objects of
+ *  each class, and (when instrumentation is enabled) how often each
+ *  function was called. An extension can add its own rows to this section
+ *  by registering a callback with Extension::onInfo(), which gets an Info
+ *  object passed:
+ *
+ *      extension.onInfo([](Php::Info &info) {
+ *          info.row("Connections", connections.size());
+ *          info.row("Lookup cache", cache.statistics());
+ *      });
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Class definition
+ */
+class Info
+{
+public:
+    /**
+     *  Constructor
+     */
+    Info() {}
+
+    /**
+     *  No copying, the object is only valid during the callback
+     *  @param  that
+     */
+    Info(const Info &that) = delete;
+
+    /**
+     *  Destructor
+     */
+    virtual ~Info() {}
+
+    /**
+     *  Add a header row
+     *  @param  name        Text in the left column
+     *  @param  value       Text in the right column
+     *  @return Info        Same object to allow chaining
+     */
+    Info &header(const std::string &name, const std::string &value);
+
+    /**
+     *  Add a row
+     *  @param  name        Text in the left column
+     *  @param  value       Text in the right column
+     *  @return Info        Same object to allow chaining
+     */
+    Info &row(const std::string &name, const std::string &value);
+    Info &row(const std::string &name, const char *value) { return row(name, std::string(value)); }
+    Info &row(const std::string &name, int64_t value) { return row(name, std::to_string(value)); }
+    Info &row(const std::string &name, size_t value) { return row(name, std::to_string(value)); }
+    Info &row(const std::string &name, int value) { return row(name, std::to_string(value)); }
+    Info &row(const std::string &name, bool value) { return row(name, std::string(value ? "enabled" : "disabled")); }
+
+    /**
+     *  Add a row with the counters of a cache
+     *  @param  name        Name of the cache
+     *  @param  statistics  The counters
+     *  @return Info        Same object to allow chaining
+     */
+    Info &row(const std::string &name, const CacheStatistics &statistics);
+};
+
+/**
+ *  Signature of the callback that adds rows to the phpinfo() section
+ */
+using InfoCallback = std::function<void(Info &info)>;
+
+/**
+ *  End namespace
+ */
+}
+
@@ -0,0 +1,243 @@
+/**
+ *  Ini.h
+ *
+ *  Class that describes a php.ini directive of the extension. The directive
+ *  is bound to a C++ variable, that is updated by the Zend engine whenever the
+ *  setting changes: when the php.ini file is loaded, when a per-directory 
+ *  setting is applied, when ini_set() is called, and when the original value 
+ *  is restored at the end of a request. Reading the setting from C++ is thus 
+ *  just a matter of reading the variable.
+ *
+ *      static int64_t limit;
+ *      extension.add(Php::Ini("myextension.limit", limit, 100));
+ *
+ *  Integer, floating point, boolean and string settings are supported, and
+ *  sizes that can be written with a K, M or G suffix (like "16M").
+ *
+ *  Such variables are shared by all threads, so on a thread safe PHP build, a
+ *  call to ini_set() in one request changes the setting for all requests. The
+ *  setting can therefore also be bound to a member of a Php::ModuleGlobals
+ *  object, which holds a separate value for each thread. The object must live
+ *  as long as the thread, otherwise the value is lost after every request:
+ *
+ *      struct Settings { int64_t limit; };
+ *      static Php::ModuleGlobals<Settings> settings(Php::Lifetime::Thread);
+ *      extension.add(Php::Ini("myextension.limit", settings, &Settings::limit, 100));
+ *
+ *      // in a function of the extension
+ *      if (count > settings->limit) ...
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Class definition
+ */
+class Ini
+{
+public:
+    /**
+     *  Places where the setting may be changed
+     */
+    enum Place : int {
+        User    =   1,      // with ini_set()
+        Perdir  =   2,      // in php.ini, .htaccess or httpd.conf
+        System  =   4,      // in php.ini or httpd.conf
+        All     =   7       // everywhere
+    };
+
+    /**
+     *  Constructor for an integer setting
+     *  @param  name        Name of the setting
+     *  @param  variable    Variable that holds the value
+     *  @param  value       Default value
+     *  @param  place       Where the setting may be changed
+     */
+    Ini(const char *name, int64_t &variable, int64_t value, Place place = All) :
+        _name(name), _value(std::to_string(value)), _place(place), _kind(Kind::Integer), _variable(&variable) {}
+
+    /**
+     *  Constructor for a floating point setting
+     *  @param  name        Name of the setting
+     *  @param  variable    Variable that holds the value
+     *  @param  value       Default value
+     *  @param  place       Where the setting may be changed
+     */
+    Ini(const char *name, double &variable, double value, Place place = All) :
+        _name(name), _value(format(value)), _place(place), _kind(Kind::Float), _variable(&variable) {}
+
+    /**
+     *  Constructor for a boolean setting
+     *  @param  name        Name of the setting
+     *  @param  variable    Variable that holds the value
+     *  @param  value       Default value
+     *  @param  place       Where the setting may be changed
+     */
+    Ini(const char *name, bool &variable, bool value, Place place = All) :
+        _name(name), _value(value ? "1" : "0"), _place(place), _kind(Kind::Bool), _variable(&variable) {}
+
+    /**
+     *  Constructor for a string setting
+     *  @param  name        Name of the setting
+     *  @param  variable    Variable that holds the value
+     *  @param  value       Default value
+     *  @param  place       Where the setting may be changed
+     */
+    Ini(const char *name, std::string &variable, const char *value, Place place = All) :
+        _name(name), _value(value), _place(place), _kind(Kind::String), _variable(&variable) {}
+
+    /**
+     *  Constructor for a size setting, the value may have a K, M or G suffix
+     *  @param  name        Name of the setting
+     *  @param  variable    Variable that holds the value in bytes
+     *  @param  value       Default value, like "16M"
+     *  @param  place       Where the setting may be changed
+     */
+    Ini(const char *name, size_t &variable, const char *value, Place place = All) :
+        _name(name), _value(value), _place(place), _kind(Kind::Size), _variable(&variable) {}
+
+    /**
+     *  Constructors for settings that are bound to a member of module globals,
+     *  so that every thread has its own value
+     *  @param  name        Name of the setting
+     *  @param  globals     The module globals, that live as long as the thread
+     *  @param  member      Member that holds the value
+     *  @param  value       Default value
+     *  @param  place       Where the setting may be changed
+     */
+    template <typename T>
+    Ini(const char *name, ModuleGlobals<T> &globals, int64_t T::*member, int64_t value, Place place = All) :
+        _name(name), _value(std::to_string(value)), _place(place), _kind(Kind::Integer), _locate(locate(globals, member)) {}
+    template <typename T>
+    Ini(const char *name, ModuleGlobals<T> &globals, double T::*member, double value, Place place = All) :
+        _name(name), _value(format(value)), _place(place), _kind(Kind::Float), _locate(locate(globals, member)) {}
+    template <typename T>
+    Ini(const char *name, ModuleGlobals<T> &globals, bool T::*member, bool value, Place place = All) :
+        _name(name), _value(value ? "1" : "0"), _place(place), _kind(Kind::Bool), _locate(locate(globals, member)) {}
+    template <typename T>
+    Ini(const char *name, ModuleGlobals<T> &globals, std::string T::*member, const char *value, Place place = All) :
+        _name(name), _value(value), _place(place), _kind(Kind::String), _locate(locate(globals, member)) {}
+    template <typename T>
+    Ini(const char *name, ModuleGlobals<T> &globals, size_t T::*member, const char *value, Place place = All) :
+        _name(name), _value(value), _place(place), _kind(Kind::Size), _locate(locate(globals, member)) {}
+
+    /**
+     *  Destructor
+     */
+    virtual ~Ini() {}
+
+    /**
+     *  Name of the setting
+     *  @return std::string
+     */
+    const std::string &name() const
+    {
+        return _name;
+    }
+
+    /**
+     *  Default value of the setting
+     *  @return std::string
+     */
+    const std::string &value() const
+    {
+        return _value;
+    }
+
+    /**
+     *  Where the setting may be changed
+     *  @return Place
+     */
+    Place place() const
+    {
+        return _place;
+    }
+
+    /**
+     *  Assign a new value to the variable, this is called by the Zend engine
+     *  @param  value       The new value
+     *  @param  size        Size of the value
+     *  @return bool        False if the value is invalid
+     */
+    bool update(const char *value, size_t size) const;
+
+private:
+    /**
+     *  The supported types of variables
+     */
+    enum class Kind : unsigned char {
+        Integer,
+        Float,
+        Bool,
+        String,
+        Size
+    };
+
+    /**
+     *  Name of the setting
+     *  @var    std::string
+     */
+    std::string _name;
+
+    /**
+     *  Default value
+     *  @var    std::string
+     */
+    std::string _value;
+
+    /**
+     *  Where the setting may be changed
+     *  @var    Place
+     */
+    Place _place;
+
+    /**
+     *  Type of the variable
+     *  @var    Kind
+     */
+    Kind _kind;
+
+    /**
+     *  The variable
+     *  @var    void*
+     */
+    void *_variable = nullptr;
+
+    /**
+     *  Function to find the variable of the current thread, for settings that
+     *  are bound to module globals
+     *  @var    std::function
+     */
+    std::function<void*()> _locate;
+
+    /**
+     *  Format a floating point value without losing precision
+     *  @param  value
+     *  @return std::string
+     */
+    static std::string format(double value);
+
+    /**
+     *  Create the function that finds a member of the module globals of the
+     *  current thread
+     *  @param  globals
+     *  @param  member
+     *  @return std::function
+     */
+    template <typename T, typename V>
+    static std::function<void*()> locate(ModuleGlobals<T> &globals, V T::*member)
+    {
+        return [&globals, member]() -> void* { return &(globals.get().*member); };
+    }
+};
+
+/**
+ *  End namespace
+ */
+}
@@ -0,0 +1,159 @@
+/**
+ *  InputStream.h
+ *
+ *  Class to read from a PHP stream, like a file handle that was opened with
+ *  fopen(), or the php://input stream with the body of a request. The data
+ *  is read by the stream functions of the Zend engine, directly into the
+ *  buffers of the C++ code, without turning it into PHP strings first.
+ *
+ *      Php::InputStream input(params[0]);
+ *
+ *      // read the stream line by line
+ *      std::string line;
+ *      while (input.getline(line)) process(line);
+ *
+ *  Big reads bypass the internal buffer of the object, and go straight into
+ *  the buffer that is passed to read(). The object can also be used by code
+ *  that expects a std::istream:
+ *
+ *      Php::InputStream input("php://input");
+ *      parser.parse(input.istream());
+ *
+ *  The object reads ahead, so data that was already buffered is no longer
+ *  available when the same stream is later read by a PHP function.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 Copernica BV
+ */
+
+/**
+ *  Forward definitions
+ */
+struct _php_stream;
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Class definition
+ */
+class InputStream : private std::streambuf
+{
+public:
+    /**
+     *  Constructor
+     *
+     *  The value is either a stream resource, or a string with the url or
+     *  path of a stream that is opened for reading.
+     *
+     *  @param  value       Stream resource, url or path
+     *  @param  size        Size of the buffer
+     */
+    InputStream(const Value &value, size_t size = 65536);
+
+    /**
+     *  No copying, the buffer and the position belong to one object
+     *  @param  that
+     */
+    InputStream(const InputStream &that) = delete;
+
+    /**
+     *  Destructor, streams that were opened by the object are also closed
+     */
+    virtual ~InputStream();
+
+    /**
+     *  Is there a stream to read from?
+     *  @return bool
+     */
+    bool valid() const { return _stream != nullptr; }
+
+    /**
+     *  Read data
+     *  @param  buffer      Buffer to fill
+     *  @param  size        Size of the buffer
+     *  @return size_t      Number of bytes read, less than size at the end of the stream
+     */
+    size_t read(char *buffer, size_t size) { return sgetn(buffer, size); }
+
+    /**
+     *  Read the next line, without the delimiter
+     *  @param  line        String to fill
+     *  @param  delimiter   Character that ends a line
+     *  @return bool        False when there are no more lines
+     */
+    bool getline(std::string &line, char delimiter = '\n');
+
+    /**
+     *  Is the end of the stream reached?
+     *  @return bool
+     */
+    bool eof() { return sgetc() == traits_type::eof(); }
+
+    /**
+     *  The object as std::istream
+     *  @return std::istream
+     */
+    std::istream &istream() { return _istream; }
+
+private:
+    /**
+     *  The stream of the Zend engine
+     *  @var    struct _php_stream
+     */
+    struct _php_stream *_stream = nullptr;
+
+    /**
+     *  The value that holds the stream resource, to keep it alive
+     *  @var    Value
+     */
+    Value _resource;
+
+    /**
+     *  Was the stream opened by this object?
+     *  @var    bool
+     */
+    bool _owner = false;
+
+    /**
+     *  The buffer
+     *  @var    std::vector
+     */
+    std::vector<char> _buffer;
+
+    /**
+     *  The std::istream that reads from this object
+     *  @var    std::istream
+     */
+    std::istream _istream;
+
+    /**
+     *  Read from the stream of the Zend engine
+     *  @param  buffer
+     *  @param  size
+     *  @return size_t
+     */
+    size_t fill(char *buffer, size_t size);
+
+    /**
+     *  Called when the buffer is empty, and more data is needed
+     *  @return int_type
+     */
+    virtual int_type underflow() override;
+
+    /**
+     *  Called to read a block of data
+     *  @param  buffer
+     *  @param  size
+     *  @return std::streamsize
+     */
+    virtual std::streamsize xsgetn(char *buffer, std::streamsize size) override;
+};
+
+/**
+ *  End namespace
+ */
+}
+
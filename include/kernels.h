@@ -0,0 +1,128 @@
+/**
+ *  Kernels.h
+ *
+ *  Numeric functions that work on PHP arrays, and that are a lot faster
+ *  than the same loops written in PHP. Each function copies the numbers
+ *  out of the array once, into a contiguous buffer of doubles, and then
+ *  runs a tight loop over it. Big arrays are split into parts that are
+ *  processed in parallel by the Php::WorkerPool threads.
+ *
+ *  The functions have the signature of a native PHP function, so they can
+ *  directly be registered in an extension:
+ *
+ *      extension.add("array_dot", Php::Kernels::dot);
+ *
+ *  Elements that are not numbers are converted, just like PHP does in
+ *  arithmetic. The keys of the input arrays are ignored.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Class definition
+ */
+class Kernels
+{
+public:
+    /**
+     *  Sum of the elements of an array
+     *  @param  params      The array
+     *  @return Value       Float
+     */
+    static Value sum(Parameters &params);
+
+    /**
+     *  Average of the elements of an array
+     *  @param  params      The array
+     *  @return Value       Float, or null for an empty array
+     */
+    static Value mean(Parameters &params);
+
+    /**
+     *  Lowest element of an array
+     *
+     *  Elements that are NaN are ignored, the result is only NaN if all
+     *  elements are NaN.
+     *
+     *  @param  params      The array
+     *  @return Value       Float, or null for an empty array
+     */
+    static Value min(Parameters &params);
+
+    /**
+     *  Highest element of an array
+     *
+     *  Elements that are NaN are ignored, the result is only NaN if all
+     *  elements are NaN.
+     *
+     *  @param  params      The array
+     *  @return Value       Float, or null for an empty array
+     */
+    static Value max(Parameters &params);
+
+    /**
+     *  Dot product of two arrays of the same size
+     *  @param  params      The two arrays
+     *  @return Value       Float
+     */
+    static Value dot(Parameters &params);
+
+    /**
+     *  Running totals of the elements of an array
+     *  @param  params      The array
+     *  @return Value       Array of floats
+     */
+    static Value prefixSum(Parameters &params);
+
+    /**
+     *  Count the elements of an array in bins of equal width
+     *
+     *  The second parameter is the number of bins. The bins are spread over
+     *  the range between the lowest and highest element, or between the
+     *  optional third and fourth parameter. Elements outside the range, and
+     *  elements that are NaN, are not counted. There can be at most 1048576
+     *  bins.
+     *
+     *  @param  params      The array, number of bins, optional lower and upper bound
+     *  @return Value       Array with the number of elements in each bin
+     */
+    static Value histogram(Parameters &params);
+
+    /**
+     *  Sort the elements of an array
+     *
+     *  Elements that are NaN can not be compared, and are placed after all
+     *  other elements.
+     *
+     *  @param  params      The array
+     *  @return Value       New array with the sorted floats
+     */
+    static Value sort(Parameters &params);
+
+private:
+    /**
+     *  Copy the numbers from a PHP array into a buffer
+     *  @param  array       The array
+     *  @return std::vector
+     */
+    static std::vector<double> buffer(const Value &array);
+
+    /**
+     *  Turn a buffer into a PHP array
+     *  @param  buffer      The numbers
+     *  @return Value
+     */
+    static Value array(const std::vector<double> &buffer);
+};
+
+/**
+ *  End namespace
+ */
+}
+
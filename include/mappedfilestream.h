@@ -0,0 +1,87 @@
+/**
+ *  MappedFileStream.h
+ *
+ *  Read-only stream over a local file, that is mapped into memory instead
+ *  of being read. A stream wrapper that stores its data in local files can
+ *  return this stream from its open() method:
+ *
+ *      Php::Stream *open(const char *path, const char *mode) override
+ *      {
+ *          if (mode[0] != 'r' || strchr(mode, '+')) return nullptr;
+ *          auto *stream = new Php::MappedFileStream(localPath(path));
+ *          if (stream->valid()) return stream;
+ *          delete stream;
+ *          return nullptr;
+ *      }
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Class definition
+ */
+class MappedFileStream : public BufferStream
+{
+public:
+    /**
+     *  Constructor
+     *  @param  path        Path of the file
+     */
+    MappedFileStream(const char *path);
+    MappedFileStream(const std::string &path) : MappedFileStream(path.c_str()) {}
+
+    /**
+     *  Destructor
+     */
+    virtual ~MappedFileStream();
+
+    /**
+     *  Was the file opened?
+     *  @return bool
+     */
+    bool valid() const { return _valid; }
+
+    /**
+     *  Retrieve information about the file
+     *  @param  stat
+     *  @return bool
+     */
+    virtual bool stat(StreamStat &stat) override;
+
+private:
+    /**
+     *  The mapped memory
+     *  @var    void *
+     */
+    void *_mapping = nullptr;
+
+    /**
+     *  Size of the mapping
+     *  @var    size_t
+     */
+    size_t _size = 0;
+
+    /**
+     *  Time of the last modification of the file
+     *  @var    time_t
+     */
+    time_t _mtime = 0;
+
+    /**
+     *  Was the file opened?
+     *  @var    bool
+     */
+    bool _valid = false;
+};
+
+/**
+ *  End namespace
+ */
+}
+
@@ -0,0 +1,171 @@
+/**
+ *  ModuleGlobals.h
+ *
+ *  Extensions that need to keep state during a request should not store it
+ *  in static C++ variables, because on a thread safe PHP build, multiple
+ *  requests are handled at the same time by different threads. Instead, the
+ *  state can be stored in a ModuleGlobals object, which holds a separate
+ *  instance of a C++ class for each thread.
+ *
+ *      struct State { int64_t counter = 0; };
+ *      static Php::ModuleGlobals<State> state;
+ *      ...
+ *      state->counter++;
+ *
+ *  The instance is constructed the first time it is accessed. By default, it
+ *  is destructed when the request ends (after the engine has destructed the
+ *  objects of the request, so their destructors can still use it), so that 
+ *  every request starts with a fresh instance. If the instance should be kept for as long as the thread 
+ *  runs, pass Php::Lifetime::Thread to the constructor.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  How long the instances of module globals live
+ */
+enum class Lifetime : unsigned char {
+    Request,
+    Thread
+};
+
+/**
+ *  Base class, that does not depend on the type of the globals
+ */
+class ModuleGlobalsBase
+{
+protected:
+    /**
+     *  Constructor
+     *  @param  lifetime    How long the instances live
+     */
+    ModuleGlobalsBase(Lifetime lifetime);
+
+    /**
+     *  Destructor
+     */
+    virtual ~ModuleGlobalsBase();
+
+    /**
+     *  Retrieve the instance of the current thread, it is created if it does
+     *  not yet exist
+     *  @return void*
+     */
+    void *pointer();
+
+    /**
+     *  Create and destroy an instance
+     *  @return void*
+     */
+    virtual void *construct() const = 0;
+    virtual void destruct(void *object) const = 0;
+
+private:
+    /**
+     *  Index of this object in the slots of a thread
+     *  @var    size_t
+     */
+    size_t _index;
+
+    /**
+     *  How long the instances live
+     *  @var    Lifetime
+     */
+    Lifetime _lifetime;
+
+    /**
+     *  Destroy the instances in the slots of a thread
+     *  @param  slots       The slots
+     *  @param  size        Number of slots
+     *  @param  all         Also destroy the instances that live as long as the thread?
+     */
+    static void release(void **slots, size_t size, bool all);
+
+    /**
+     *  The extension destroys the instances
+     */
+    friend class ExtensionImpl;
+};
+
+/**
+ *  Class definition
+ */
+template <typename T>
+class ModuleGlobals : public ModuleGlobalsBase
+{
+public:
+    /**
+     *  Constructor
+     *  @param  lifetime    How long the instances live
+     */
+    ModuleGlobals(Lifetime lifetime = Lifetime::Request) : ModuleGlobalsBase(lifetime) {}
+
+    /**
+     *  No copying or moving
+     *  @param  that
+     */
+    ModuleGlobals(const ModuleGlobals &that) = delete;
+    ModuleGlobals(ModuleGlobals &&that) = delete;
+
+    /**
+     *  Destructor
+     */
+    virtual ~ModuleGlobals() {}
+
+    /**
+     *  Access the instance of the current thread
+     *  @return T
+     */
+    T *operator->()
+    {
+        return (T *)pointer();
+    }
+
+    /**
+     *  Access the instance of the current thread
+     *  @return T
+     */
+    T &operator*()
+    {
+        return *(T *)pointer();
+    }
+
+    /**
+     *  Access the instance of the current thread
+     *  @return T
+     */
+    T &get()
+    {
+        return *(T *)pointer();
+    }
+
+protected:
+    /**
+     *  Create an instance
+     *  @return void*
+     */
+    virtual void *construct() const override
+    {
+        return new T();
+    }
+
+    /**
+     *  Destroy an instance
+     *  @param  object
+     */
+    virtual void destruct(void *object) const override
+    {
+        delete (T *)object;
+    }
+};
+
+/**
+ *  End namespace
+ */
+}
@@ -174,6 +174,22 @@ public:
         return result;
     }
     
+    /**
+     *  The total number of nested namespaces
+     *  @return size_t
+     */
+    size_t namespaces()
+    {
+        // number of namespaces in this namespace
+        size_t result = _namespaces.size();
+        
+        // number of namespaces in sub-namespaces
+        for (auto &ns : _namespaces) result += ns->namespaces();
+        
+        // done
+        return result;
+    }
+    
     /**
      *  Apply a callback to each registered function
      * 
@@ -0,0 +1,78 @@
+/**
+ *  PoolStatistics.h
+ *
+ *  Counters that describe how well the object pool of a class performs. If
+ *  you have enabled object recycling for a class with Php::Class::pool(),
+ *  you can retrieve these counters to find out how many objects were really
+ *  allocated, and how many of them were recycled.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Class definition
+ */
+class PoolStatistics
+{
+public:
+    /**
+     *  Max number of idle objects that are kept in the pool
+     *  @var    size_t
+     */
+    size_t capacity = 0;
+
+    /**
+     *  Number of idle objects that are currently in the pool
+     *  @var    size_t
+     */
+    size_t idle = 0;
+
+    /**
+     *  Number of objects that were allocated because the pool was empty
+     *  @var    size_t
+     */
+    size_t allocated = 0;
+
+    /**
+     *  Number of objects that were taken from the pool instead of being allocated
+     *  @var    size_t
+     */
+    size_t reused = 0;
+
+    /**
+     *  Number of objects that were put back in the pool
+     *  @var    size_t
+     */
+    size_t released = 0;
+
+    /**
+     *  Number of objects that were destructed because the pool was full
+     *  @var    size_t
+     */
+    size_t discarded = 0;
+
+    /**
+     *  The fraction of object creations that were served from the pool
+     *  @return double
+     */
+    double reuseRate() const
+    {
+        // prevent division by zero
+        if (allocated + reused == 0) return 0.0;
+
+        // calculate the rate
+        return (double)reused / (allocated + reused);
+    }
+};
+
+/**
+ *  End namespace
+ */
+}
+
@@ -0,0 +1,101 @@
+/**
+ *  RequestArena.h
+ *
+ *  Memory for temporary C++ data that is needed only during a single request
+ *  can be allocated from the request arena. Allocations are very cheap, 
+ *  because the arena simply hands out the next part of a big block of 
+ *  memory, and the memory is not freed one allocation at a time: all memory
+ *  is released in one go when the request ends (after the onIdle() callback,
+ *  and after the engine has destructed all objects of the request).
+ *
+ *  The blocks are allocated by the Zend engine, so the memory counts for the
+ *  PHP memory_limit. This also means that the arena can only be used while
+ *  a request is being handled, and not during the onStartup() callback.
+ *
+ *  Objects that are constructed in arena memory are not destructed by the
+ *  arena. The arena is therefore best used for plain data, or for containers
+ *  that use the Php::ArenaAllocator class.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Class definition
+ */
+class RequestArena
+{
+public:
+    /**
+     *  Allocate memory that is valid until the end of the request
+     *  @param  size        Number of bytes
+     *  @param  alignment   Required alignment, must be a power of two
+     *  @return void*
+     */
+    static void *allocate(size_t size, size_t alignment = alignof(long double));
+
+    /**
+     *  Allocate memory for an array of objects that is valid until the end
+     *  of the request. The objects are not constructed.
+     *  @param  count       Number of objects
+     *  @return T*
+     */
+    template <typename T>
+    static T *allocate(size_t count = 1)
+    {
+        // the total size may not overflow
+        if (count > SIZE_MAX / sizeof(T)) throw std::bad_alloc();
+        
+        // allocate the array
+        return static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+    }
+
+    /**
+     *  Copy a string into the arena
+     *  @param  data        The string
+     *  @param  size        Size of the string
+     *  @return const char* Null terminated copy
+     */
+    static const char *copy(const char *data, size_t size)
+    {
+        // the terminating null may not overflow the size
+        if (size == SIZE_MAX) throw std::bad_alloc();
+        
+        // allocate room for the string and the terminating null
+        char *result = static_cast<char*>(allocate(size + 1, 1));
+
+        // copy the data
+        memcpy(result, data, size);
+        result[size] = '\0';
+
+        // done
+        return result;
+    }
+
+    /**
+     *  Retrieve the counters of the arena
+     *  @return ArenaStatistics
+     */
+    static ArenaStatistics statistics();
+
+private:
+    /**
+     *  Release all memory, this is called when the request ends
+     */
+    static void release();
+
+    /**
+     *  The extension releases the memory
+     */
+    friend class ExtensionImpl;
+};
+
+/**
+ *  End namespace
+ */
+}
@@ -0,0 +1,119 @@
+/**
+ *  SharedCache.h
+ *
+ *  A key/value cache in shared memory, that can be used by all processes of
+ *  a forking server (like php-fpm or apache prefork). The memory is mapped
+ *  when the cache is constructed, so the cache must be created in the 
+ *  onStartup() callback, before the worker processes are forked. All workers
+ *  then share the same entries.
+ *
+ *  The size of the cache is fixed. The entries are stored in a hash table 
+ *  that is divided into small groups of slots, every group has its own lock
+ *  for writers, while readers do not lock at all. When a group is full, the
+ *  oldest entry in the group is replaced. The values are stored in a compact
+ *  binary format, in memory that is managed by a slab allocator. A single
+ *  entry can not be bigger than one megabyte.
+ *
+ *  The allocator hands out the memory in pages of one megabyte, and every 
+ *  page holds entries of about the same size. When all pages are in use, an
+ *  entry can only be stored by evicting older entries of about the same size,
+ *  so when the sizes of the entries change over time, set() can fail while
+ *  there still is memory in use by entries of other sizes. 
+ *
+ *  A worker that dies while it is writing to the cache (because it crashed, 
+ *  or because it was killed) does not block the other workers. The entries 
+ *  that it was modifying are lost.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Forward declarations
+ */
+class SharedCacheImpl;
+
+/**
+ *  Class definition
+ */
+class SharedCache
+{
+public:
+    /**
+     *  Constructor
+     *  @param  size        Size of the shared memory segment in bytes
+     *  @param  entries     Max number of entries
+     */
+    SharedCache(size_t size, size_t entries = 65536);
+
+    /**
+     *  No copying or moving
+     *  @param  that
+     */
+    SharedCache(const SharedCache &that) = delete;
+    SharedCache(SharedCache &&that) = delete;
+
+    /**
+     *  Destructor
+     */
+    virtual ~SharedCache();
+
+    /**
+     *  Was the shared memory segment created?
+     *  @return bool
+     */
+    bool valid() const;
+
+    /**
+     *  Store a PHP value
+     *  @param  key         The key
+     *  @param  value       Value to store
+     *  @return bool        False if the value is too big, or if there was no room
+     *                      for it and no entries of the same size to evict
+     */
+    bool set(const std::string &key, const Value &value);
+
+    /**
+     *  Retrieve a PHP value
+     *  @param  key         The key
+     *  @return Value       The value, or NULL if it was not found
+     */
+    Value get(const std::string &key);
+
+    /**
+     *  Check if an entry exists
+     *  @param  key         The key
+     *  @return bool
+     */
+    bool exists(const std::string &key);
+
+    /**
+     *  Remove an entry
+     *  @param  key         The key
+     *  @return bool        Was the entry found?
+     */
+    bool remove(const std::string &key);
+
+    /**
+     *  Retrieve the counters of the cache, these are shared by all processes
+     *  @return CacheStatistics
+     */
+    CacheStatistics statistics() const;
+
+private:
+    /**
+     *  The implementation
+     *  @var    SharedCacheImpl
+     */
+    SharedCacheImpl *_impl;
+};
+
+/**
+ *  End namespace
+ */
+}
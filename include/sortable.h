@@ -0,0 +1,49 @@
+/**
+ *  Sortable.h
+ *
+ *  Interface that can be implemented by classes whose objects have a natural
+ *  order, that can be expressed with a single key. Arrays with such objects
+ *  can be sorted with the Php::sort() function. This function fetches the
+ *  key of each object only once, and sorts the objects by comparing the keys
+ *  natively, without calling __compare() or a user space callback.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Class definition
+ */
+class Sortable
+{
+public:
+    /**
+     *  Retrieve the key by which the object is sorted
+     *  @return SortKey
+     */
+    virtual SortKey sortKey() const = 0;
+};
+
+/**
+ *  Sort an array of objects that implement the Sortable interface
+ * 
+ *  The array is sorted in place, and just like the PHP usort() function,
+ *  the elements are renumbered. Elements with equal keys keep their original
+ *  order. If one of the elements is not an object that implements the 
+ *  Sortable interface, the array is left alone and false is returned.
+ * 
+ *  @param  array       The array to sort
+ *  @param  descending  Sort from high to low?
+ *  @return bool
+ */
+bool sort(Value &array, bool descending = false);
+
+/**
+ *  End namespace
+ */
+}
@@ -0,0 +1,171 @@
+/**
+ *  SortKey.h
+ *
+ *  A sort key is returned by objects that implement the Sortable interface.
+ *  It holds an integer, a floating point number or a string of bytes, and 
+ *  can be compared without calling back into the object.
+ *
+ *  Integers and floating point numbers are compared by their numeric value,
+ *  strings are compared byte by byte. Numbers are always ordered before 
+ *  strings, and NaN is ordered after all other numbers.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Class definition
+ */
+class SortKey
+{
+public:
+    /**
+     *  Constructor for integer keys of any integral type (unsigned values
+     *  that do not fit in an int64_t are stored as floating point number)
+     *  @param  value
+     */
+    template <typename T, typename = typename std::enable_if<std::is_integral<T>::value>::type>
+    SortKey(T value) : _type(Type::Numeric)
+    {
+        // check if the value fits
+        if (std::is_unsigned<T>::value && (uint64_t)value > (uint64_t)INT64_MAX) 
+        {
+            // store as floating point number
+            _type = Type::Float;
+            _number.floating = (double)value;
+        }
+        else
+        {
+            // store as integer
+            _number.integer = (int64_t)value;
+        }
+    }
+    
+    /**
+     *  Constructor for floating point keys
+     *  @param  value
+     */
+    SortKey(double value) : _type(Type::Float) { _number.floating = value; }
+    
+    /**
+     *  Constructors for string keys
+     *  @param  value
+     */
+    SortKey(const std::string &value) : _type(Type::String), _string(value) {}
+    SortKey(std::string &&value) : _type(Type::String), _string(std::move(value)) {}
+    SortKey(const char *value) : _type(Type::String), _string(value) {}
+    SortKey(const char *value, size_t size) : _type(Type::String), _string(value, size) {}
+    
+    /**
+     *  The type of key: Type::Numeric, Type::Float or Type::String
+     *  @return Type
+     */
+    Type type() const
+    {
+        return _type;
+    }
+    
+    /**
+     *  Compare with a different key
+     *  @param  that
+     *  @return int         Less than zero, zero or greater than zero
+     */
+    int compare(const SortKey &that) const
+    {
+        // strings are ordered after numbers
+        if (_type == Type::String || that._type == Type::String)
+        {
+            // compare strings byte by byte
+            if (_type == that._type) return _string.compare(that._string);
+            
+            // only one of them is a string
+            return _type == Type::String ? 1 : -1;
+        }
+        
+        // two integers can be compared without a conversion
+        if (_type == Type::Numeric && that._type == Type::Numeric)
+        {
+            return _number.integer < that._number.integer ? -1 : _number.integer > that._number.integer ? 1 : 0;
+        }
+        
+        // an integer and a floating point number are compared exactly
+        if (_type == Type::Numeric) return compare(_number.integer, that._number.floating);
+        if (that._type == Type::Numeric) return -compare(that._number.integer, _number.floating);
+        
+        // compare two floating point numbers
+        double a = _number.floating, b = that._number.floating;
+        
+        // NaN is ordered after all other numbers, otherwise sorting is undefined
+        bool nanA = a != a, nanB = b != b;
+        if (nanA || nanB) return (int)nanA - (int)nanB;
+        
+        // compare the numbers
+        return a < b ? -1 : a > b ? 1 : 0;
+    }
+    
+    /**
+     *  Comparison operators
+     *  @param  that
+     *  @return bool
+     */
+    bool operator< (const SortKey &that) const { return compare(that) <  0; }
+    bool operator> (const SortKey &that) const { return compare(that) >  0; }
+    bool operator==(const SortKey &that) const { return compare(that) == 0; }
+    bool operator!=(const SortKey &that) const { return compare(that) != 0; }
+
+private:
+    /**
+     *  The type of key
+     *  @var    Type
+     */
+    Type _type;
+
+    /**
+     *  Numeric value
+     */
+    union {
+        int64_t integer;
+        double floating;
+    } _number;
+
+    /**
+     *  String value
+     *  @var    std::string
+     */
+    std::string _string;
+    
+    /**
+     *  Compare an integer with a floating point number without converting 
+     *  the integer, a conversion to double would lose precision above 2^53
+     *  @param  integer
+     *  @param  floating
+     *  @return int         Less than zero, zero or greater than zero
+     */
+    static int compare(int64_t integer, double floating)
+    {
+        // NaN is ordered after all other numbers
+        if (floating != floating) return -1;
+        
+        // numbers outside the int64_t range (2^63 and -2^63 are exact doubles)
+        if (floating >= 9223372036854775808.0) return -1;
+        if (floating < -9223372036854775808.0) return 1;
+        
+        // compare the integral part, which now fits in an int64_t
+        int64_t integral = (int64_t)floating;
+        if (integer != integral) return integer < integral ? -1 : 1;
+        
+        // the integral parts are equal, so the fraction decides
+        double fraction = floating - (double)integral;
+        return fraction > 0.0 ? -1 : fraction < 0.0 ? 1 : 0;
+    }
+};
+
+/**
+ *  End namespace
+ */
+}
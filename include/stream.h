@@ -0,0 +1,130 @@
+/**
+ *  Stream.h
+ *
+ *  Base class for the streams that are opened by a Php::StreamWrapper. When
+ *  a PHP script calls fopen(), file_get_contents() or any other function that
+ *  opens a url of a registered protocol, the wrapper creates a stream object,
+ *  and the reads, writes and seeks of the script are passed on to it.
+ *
+ *  All methods have a default implementation, so a derived class only has
+ *  to implement what it supports. A read-only stream can also expose its
+ *  complete contents by implementing contents(). Functions like
+ *  stream_copy_to_stream() and fpassthru() then use that memory directly,
+ *  instead of reading the data chunk by chunk into a buffer of their own.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Information about a stream, or about the resource behind a url
+ */
+struct StreamStat
+{
+    /**
+     *  Size in bytes
+     *  @var    int64_t
+     */
+    int64_t size = 0;
+
+    /**
+     *  Time of the last modification
+     *  @var    time_t
+     */
+    time_t mtime = 0;
+
+    /**
+     *  Can the resource be written?
+     *  @var    bool
+     */
+    bool writable = false;
+
+    /**
+     *  Is it a directory?
+     *  @var    bool
+     */
+    bool directory = false;
+};
+
+/**
+ *  Class definition
+ */
+class Stream
+{
+public:
+    /**
+     *  Constructor
+     */
+    Stream() {}
+
+    /**
+     *  No copying, the stream is owned by the engine
+     *  @param  that
+     */
+    Stream(const Stream &that) = delete;
+
+    /**
+     *  Destructor, called when the stream is closed
+     */
+    virtual ~Stream() {}
+
+    /**
+     *  Read data from the stream
+     *  @param  buffer      Buffer to fill
+     *  @param  size        Size of the buffer
+     *  @return size_t      Number of bytes read, 0 at the end of the stream
+     */
+    virtual size_t read(char *buffer, size_t size) { return 0; }
+
+    /**
+     *  Write data to the stream
+     *  @param  data        Data to write
+     *  @param  size        Size of the data
+     *  @return size_t      Number of bytes written
+     */
+    virtual size_t write(const char *data, size_t size) { return 0; }
+
+    /**
+     *  Move to a different position
+     *  @param  offset      The offset
+     *  @param  whence      SEEK_SET, SEEK_CUR or SEEK_END
+     *  @return int64_t     The new position, or -1 if the stream can not seek
+     */
+    virtual int64_t seek(int64_t offset, int whence) { return -1; }
+
+    /**
+     *  Write out the data that is buffered by the stream
+     *  @return bool
+     */
+    virtual bool flush() { return true; }
+
+    /**
+     *  Retrieve information about the stream
+     *  @param  stat        Object to fill
+     *  @return bool        Is the information available?
+     */
+    virtual bool stat(StreamStat &stat) { return false; }
+
+    /**
+     *  Retrieve the complete contents of a read-only stream
+     *
+     *  The memory must stay valid, and may not change, until the stream is
+     *  destructed. Streams that do not have their data in memory return
+     *  a null pointer.
+     *
+     *  @param  size        Will be filled with the size of the contents
+     *  @return const char*
+     */
+    virtual const char *contents(size_t &size) { return nullptr; }
+};
+
+/**
+ *  End namespace
+ */
+}
+
@@ -9,6 +9,12 @@
  *  Php::out << "this is example text" << std::endl;
  *  Php::err << "this is an error message" << std::endl;
  *
+ *  Output to Php::out is buffered, and is sent to PHP when the buffer is 
+ *  full, when the stream is flushed, and when the C++ function returns. The
+ *  buffer holds 64KB by default, this can be changed with:
+ *
+ *  Php::out.rdbuf()->pubsetbuf(nullptr, 1024 * 1024);
+ *
  *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
  *  @copyright 2014 Copernica BV
  */
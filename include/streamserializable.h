@@ -0,0 +1,52 @@
+/**
+ *  StreamSerializable interface
+ *
+ *  This interface can be implemented, as an alternative to the Serializable
+ *  interface, to make an object that can be passed to the PHP serialize()
+ *  and unserialize() methods. Instead of returning a string, the object
+ *  writes its state into an Encoder, and reads it back with a Decoder. The
+ *  data is stored in a compact binary format, directly in a buffer that is
+ *  owned by the Zend engine.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Class definition
+ */
+class StreamSerializable
+{
+public:
+    /**
+     *  Method to serialize the object
+     *
+     *  This method should write everything that is needed to revive the
+     *  object into the encoder
+     *
+     *  @param  encoder         Encoder to write to
+     */
+    virtual void serialize(Encoder &encoder) = 0;
+
+    /**
+     *  Unserialize the object
+     *
+     *  This method is called as an alternative __construct() method to initialize
+     *  the object. The decoder holds the data that was earlier written by a
+     *  call to serialize(), and should be read back in the same order
+     *
+     *  @param  decoder         Decoder to read from
+     */
+    virtual void unserialize(Decoder &decoder) = 0;
+};
+
+/**
+ *  End namespace
+ */
+}
+
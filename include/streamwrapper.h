@@ -0,0 +1,121 @@
+/**
+ *  StreamWrapper.h
+ *
+ *  Base class for a handler of urls of a custom protocol. When the wrapper
+ *  is added to the extension, PHP functions like fopen(), file_get_contents(),
+ *  file_put_contents(), file_exists() and unlink() pass urls that start with
+ *  the protocol to the methods of the wrapper:
+ *
+ *      class Storage : public Php::StreamWrapper
+ *      {
+ *      public:
+ *          Storage() : Php::StreamWrapper("storage") {}
+ *
+ *          virtual Php::Stream *open(const char *path, const char *mode) override
+ *          {
+ *              // path is the complete url, like "storage://images/logo.png"
+ *              auto blob = blobs.find(path + 10);
+ *
+ *              // urls that are not found can not be opened
+ *              return blob ? new Php::BufferStream(blob) : nullptr;
+ *          }
+ *      };
+ *
+ *      extension.add(std::make_shared<Storage>());
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Forward declarations
+ */
+class StreamWrapperImpl;
+
+/**
+ *  Class definition
+ */
+class StreamWrapper
+{
+public:
+    /**
+     *  Constructor
+     *  @param  protocol    The protocol, without the "://"
+     */
+    StreamWrapper(const char *protocol);
+
+    /**
+     *  No copying or moving, the engine holds a pointer to the wrapper
+     *  @param  that
+     */
+    StreamWrapper(const StreamWrapper &that) = delete;
+    StreamWrapper(StreamWrapper &&that) = delete;
+
+    /**
+     *  Destructor
+     */
+    virtual ~StreamWrapper();
+
+    /**
+     *  Open a url
+     *
+     *  The returned stream is destructed by the library when the script
+     *  closes it. An exception that is thrown is reported as a warning.
+     *
+     *  @param  path        The complete url
+     *  @param  mode        Mode like "r", "rb" or "w", as passed to fopen()
+     *  @return Stream      New stream, or nullptr if the url can not be opened
+     */
+    virtual Stream *open(const char *path, const char *mode) = 0;
+
+    /**
+     *  Retrieve information about a url, for functions like file_exists(),
+     *  filesize() and is_dir()
+     *  @param  path        The complete url
+     *  @param  stat        Object to fill
+     *  @return bool        Does the url exist?
+     */
+    virtual bool stat(const char *path, StreamStat &stat) { return false; }
+
+    /**
+     *  Remove the resource behind a url
+     *  @param  path        The complete url
+     *  @return bool
+     */
+    virtual bool unlink(const char *path) { return false; }
+
+    /**
+     *  The protocol
+     *  @return std::string
+     */
+    const std::string &protocol() const { return _protocol; }
+
+private:
+    /**
+     *  The protocol
+     *  @var    std::string
+     */
+    std::string _protocol;
+
+    /**
+     *  The implementation object
+     *  @var    StreamWrapperImpl
+     */
+    StreamWrapperImpl *_impl;
+
+    /**
+     *  The extension registers the wrapper
+     */
+    friend class ExtensionImpl;
+};
+
+/**
+ *  End namespace
+ */
+}
+
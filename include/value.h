@@ -950,6 +950,9 @@ protected:
     friend class HashMember<int>;
     friend class HashMember<std::string>;
     friend class Callable;
+    friend bool sort(Value &array, bool descending);
+    friend class Kernels;
+    friend class InputStream;
 };
 
 /**
@@ -0,0 +1,115 @@
+/**
+ *  WorkerPool.h
+ *
+ *  A pool of background threads that extensions can use to run CPU heavy
+ *  C++ code (compression, hashing, numeric kernels) in parallel. The tasks
+ *  are submitted from the request thread, and a std::future is returned
+ *  that can be used to wait for the result.
+ *
+ *      std::vector<double> data = ...;
+ *      auto first = Php::WorkerPool::submit([&data]() { return sum(data, 0, half); });
+ *      auto second = Php::WorkerPool::submit([&data]() { return sum(data, half, size); });
+ *      return first.get() + second.get();
+ *
+ *  The tasks run on threads that are not known to the Zend engine, so they
+ *  may NOT touch Php::Value objects or call any PHP function. Copy the input
+ *  into plain C++ variables first, and turn the result into a Php::Value
+ *  after the future has been joined on the request thread.
+ *
+ *  The threads are started the first time a task is submitted, and stopped
+ *  (after the pending tasks are finished) when the module shuts down. Every
+ *  thread has its own queue, and threads that run out of work steal tasks
+ *  from the others. When the queues are full, the task is executed right
+ *  away by the thread that submits it. This also happens to tasks that are
+ *  submitted by a task that runs in the pool, so that a task can safely 
+ *  wait for the tasks that it submitted.
+ *
+ *  The threads do not survive a fork(). In the child process, the pool is
+ *  started again when the first task is submitted. Tasks that were still 
+ *  waiting in the queues at the time of the fork only run in the parent.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Class definition
+ */
+class WorkerPool
+{
+public:
+    /**
+     *  Submit a task
+     *
+     *  The task can be any callable object without parameters. Exceptions
+     *  that are thrown by the task are rethrown by the get() method of
+     *  the future.
+     *
+     *  @param  task        The task to run
+     *  @return std::future
+     */
+    template <typename F>
+    static std::future<typename std::result_of<F()>::type> submit(F &&task)
+    {
+        // the type of the result
+        typedef typename std::result_of<F()>::type Result;
+
+        // wrap the task so that its result ends up in the future
+        auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(task));
+
+        // get the future before the task might run
+        auto future = packaged->get_future();
+
+        // add it to the queues
+        push([packaged]() { (*packaged)(); });
+
+        // done
+        return future;
+    }
+
+    /**
+     *  Set the number of threads and the size of the queues
+     *
+     *  This only has effect if it is called before the first task is
+     *  submitted, for example from the onStartup() callback. By default,
+     *  there is a thread for every core, and each queue holds 1024 tasks.
+     *
+     *  @param  threads     Number of threads
+     *  @param  capacity    Maximum number of pending tasks per thread
+     */
+    static void setup(size_t threads, size_t capacity = 1024);
+
+    /**
+     *  Number of threads in the pool
+     *  @return size_t
+     */
+    static size_t size();
+
+private:
+    /**
+     *  Add a task to the queues
+     *  @param  task
+     */
+    static void push(std::function<void()> &&task);
+
+    /**
+     *  Stop the threads, after the pending tasks are finished
+     */
+    static void shutdown();
+
+    /**
+     *  The extension stops the pool
+     */
+    friend class ExtensionImpl;
+};
+
+/**
+ *  End namespace
+ */
+}
+
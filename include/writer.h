@@ -0,0 +1,186 @@
+/**
+ *  Writer.h
+ *
+ *  Lightweight alternative for Php::out, for extensions that generate a lot
+ *  of output. Php::out is a std::ostream, which means that every << operator
+ *  constructs a sentry, consults the locale and formats numbers with the
+ *  generic iostream machinery. The Writer class only appends bytes to a
+ *  buffer, and has its own conversions for numbers and escaped strings.
+ *
+ *      Php::Writer writer;
+ *      writer << "<td>" << id << "</td><td>";
+ *      writer.html(name).write("</td>");
+ *
+ *  The writer sends its data to the same buffer as Php::out, when its own
+ *  buffer is full, when flush() is called, and when it is destructed.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Class definition
+ */
+class Writer
+{
+public:
+    /**
+     *  Constructor
+     */
+    Writer() {}
+
+    /**
+     *  No copying, the buffered data can only be written once
+     *  @param  that
+     */
+    Writer(const Writer &that) = delete;
+
+    /**
+     *  Destructor
+     */
+    virtual ~Writer()
+    {
+        // send out the remaining data
+        flush();
+    }
+
+    /**
+     *  Write raw bytes
+     *  @param  data
+     *  @param  size
+     *  @return Writer
+     */
+    Writer &write(const char *data, size_t size)
+    {
+        // small data is copied into the buffer
+        if (size <= sizeof(_buffer) - _size)
+        {
+            memcpy(_buffer + _size, data, size);
+            _size += size;
+            return *this;
+        }
+
+        // bigger data is handled out of line
+        return writeLarge(data, size);
+    }
+
+    /**
+     *  Write a string
+     *  @param  value
+     *  @return Writer
+     */
+    Writer &write(const char *value) { return write(value, ::strlen(value)); }
+    Writer &write(const std::string &value) { return write(value.data(), value.size()); }
+    Writer &write(const Value &value);
+
+    /**
+     *  Write a single character
+     *  @param  value
+     *  @return Writer
+     */
+    Writer &write(char value)
+    {
+        // make sure there is room
+        if (_size == sizeof(_buffer)) flush();
+
+        // add the character
+        _buffer[_size++] = value;
+        return *this;
+    }
+
+    /**
+     *  Write a number
+     *
+     *  Floating point numbers are written with the fewest digits that are
+     *  needed to read back exactly the same number, and always with a dot
+     *  as decimal point, whatever the locale is.
+     *
+     *  @param  value
+     *  @return Writer
+     */
+    Writer &write(int value) { return writeSigned(value); }
+    Writer &write(long value) { return writeSigned(value); }
+    Writer &write(long long value) { return writeSigned(value); }
+    Writer &write(unsigned value) { return writeUnsigned(value); }
+    Writer &write(unsigned long value) { return writeUnsigned(value); }
+    Writer &write(unsigned long long value) { return writeUnsigned(value); }
+    Writer &write(double value);
+
+    /**
+     *  Write a string, with the special HTML characters (& < > " and ')
+     *  replaced by entities, just like htmlspecialchars() does
+     *  @param  data
+     *  @param  size
+     *  @return Writer
+     */
+    Writer &html(const char *data, size_t size);
+    Writer &html(const char *value) { return html(value, ::strlen(value)); }
+    Writer &html(const std::string &value) { return html(value.data(), value.size()); }
+    Writer &html(const Value &value);
+
+    /**
+     *  Write the contents of a JSON string, with quotes, backslashes and
+     *  control characters escaped (the surrounding quotes are not written,
+     *  and UTF-8 characters are left alone)
+     *  @param  data
+     *  @param  size
+     *  @return Writer
+     */
+    Writer &json(const char *data, size_t size);
+    Writer &json(const char *value) { return json(value, ::strlen(value)); }
+    Writer &json(const std::string &value) { return json(value.data(), value.size()); }
+    Writer &json(const Value &value);
+
+    /**
+     *  Stream operator, does the same as write()
+     *  @param  value
+     *  @return Writer
+     */
+    template <typename T>
+    Writer &operator<<(const T &value) { return write(value); }
+
+    /**
+     *  Send the buffered data to the output buffer of Php::out
+     */
+    void flush();
+
+private:
+    /**
+     *  The buffer
+     *  @var    char[]
+     */
+    char _buffer[4096];
+
+    /**
+     *  Number of bytes in the buffer
+     *  @var    size_t
+     */
+    size_t _size = 0;
+
+    /**
+     *  Write data that does not fit in the buffer
+     *  @param  data
+     *  @param  size
+     *  @return Writer
+     */
+    Writer &writeLarge(const char *data, size_t size);
+
+    /**
+     *  Write integers
+     *  @param  value
+     *  @return Writer
+     */
+    Writer &writeSigned(int64_t value);
+    Writer &writeUnsigned(uint64_t value);
+};
+
+/**
+ *  End namespace
+ */
+}
+
@@ -14,13 +14,20 @@
  *  Other C and C++ libraries that PhpCpp depends on
  */
 #include <string.h>
+#include <stdio.h>
+#include <time.h>
 #include <string>
+#include <istream>
 #include <initializer_list>
 #include <vector>
 #include <memory>
 #include <list>
 #include <exception>
+#include <new>
 #include <map>
+#include <type_traits>
+#include <typeinfo>
+#include <future>
 
 /**
  *  Include all headers files that are related to this library
@@ -46,14 +53,40 @@
 #include <phpcpp/base.h>
 #include <phpcpp/countable.h>
 #include <phpcpp/arrayaccess.h>
+#include <phpcpp/indexaccess.h>
+#include <phpcpp/sortkey.h>
+#include <phpcpp/sortable.h>
 #include <phpcpp/iterator.h>
+#include <phpcpp/chunkediterator.h>
 #include <phpcpp/traversable.h>
 #include <phpcpp/serializable.h>
+#include <phpcpp/encoder.h>
+#include <phpcpp/decoder.h>
+#include <phpcpp/streamserializable.h>
 #include <phpcpp/classtype.h>
+#include <phpcpp/poolstatistics.h>
+#include <phpcpp/arenastatistics.h>
+#include <phpcpp/requestarena.h>
+#include <phpcpp/arenaallocator.h>
+#include <phpcpp/cachestatistics.h>
+#include <phpcpp/cache.h>
+#include <phpcpp/moduleglobals.h>
+#include <phpcpp/sharedcache.h>
+#include <phpcpp/workerpool.h>
+#include <phpcpp/kernels.h>
+#include <phpcpp/writer.h>
+#include <phpcpp/stream.h>
+#include <phpcpp/bufferstream.h>
+#include <phpcpp/mappedfilestream.h>
+#include <phpcpp/streamwrapper.h>
+#include <phpcpp/inputstream.h>
+#include <phpcpp/datamember.h>
 #include <phpcpp/classbase.h>
 #include <phpcpp/interface.h>
 #include <phpcpp/class.h>
 #include <phpcpp/namespace.h>
+#include <phpcpp/ini.h>
+#include <phpcpp/info.h>
 #include <phpcpp/extension.h>
 #include <phpcpp/call.h>
 
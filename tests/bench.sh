@@ -0,0 +1,57 @@
+#!/bin/bash
+#
+# Run the microbenchmarks in php/bench with the test extension. Run test.sh
+# first to compile the extension, and use -p to compare a thread safe PHP
+# build with a regular build:
+#
+#   ./bench.sh -p /usr/local/php-zts/bin/php
+#
+
+THIS=`basename $0`
+
+function print_help() {
+    echo "Use: $THIS [options...] [rounds]"
+    echo "Options:"
+    echo "  -p <php>     Specify PHP executable to run (default: /usr/bin/php)."
+    echo "  -e <file>    Name of test extension (default: extfortest.so)."
+    echo "  -h           This Help."
+    echo
+    exit;
+}
+
+PHP_BIN="/usr/bin/php"
+EXT_NAME="extfortest.so"
+
+while getopts ":p:e:h" opt ;
+do
+    case $opt in
+        p)
+            PHP_BIN=$OPTARG;
+            ;;
+        e)
+            EXT_NAME=$OPTARG;
+            ;;
+        h)
+            print_help
+            ;;
+        *)
+            echo "wrong option -$OPTARG";
+            echo "";
+            print_help
+            ;;
+    esac
+done
+shift $((OPTIND - 1))
+
+# Create a local copy of the directory with the extension for run without installation
+./prepare.sh $EXT_NAME
+
+# Absolute path to library
+LIBRARY_PATH="$(cd $PWD/.. && echo $PWD)"
+LD_LIBRARY_PATH="${LIBRARY_PATH}:${LD_LIBRARY_PATH}"
+export LD_LIBRARY_PATH
+
+# run the benchmarks
+for BENCH in `find ./php/bench -type f -name "*.php" | sort`; do
+    $PHP_BIN -d extension_dir=$PWD/ext_dir -d extension=$EXT_NAME $BENCH $1
+done
@@ -8,7 +8,19 @@
 #include "../include/class_obj/001-002.h"
 #include "../include/class_obj/003-comparable.h"
 #include "../include/class_obj/004-static-funct.h"
-//#include "../include/class_obj/.h"
-//#include "../include/class_obj/.h"
+#include "../include/class_obj/006-object-pool.h"
+#include "../include/class_obj/007-dynamic-methods.h"
+#include "../include/class_obj/008-data-members.h"
+#include "../include/class_obj/010-stream-serializable.h"
+#include "../include/class_obj/012-index-access.h"
+#include "../include/class_obj/013-chunked-iterator.h"
+#include "../include/class_obj/014-sortable.h"
+#include "../include/class_obj/015-request-arena.h"
+#include "../include/class_obj/016-cache.h"
+#include "../include/class_obj/017-shared-cache.h"
+#include "../include/class_obj/019-module-globals.h"
+#include "../include/class_obj/020-worker-pool.h"
+#include "../include/class_obj/025-stream-wrapper.h"
+#include "../include/class_obj/026-input-stream.h"
 //#include "../include/class_obj/.h"
 
@@ -0,0 +1,15 @@
+/**
+ *  
+ *
+ *  extension.h
+ *
+ *  Tests of the features of the extension: php.ini settings, numeric
+ *  kernels and output
+ *
+ */
+
+#include "../include/extension/001-ini.h"
+#include "../include/extension/003-output.h"
+#include "../include/extension/004-writer.h"
+//#include "../include/extension/.h"
+
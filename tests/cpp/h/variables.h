@@ -22,6 +22,7 @@
 #include "../include/variables/020-HashMember-2.h"
 #include "../include/variables/021-HashMember-3.h"
 #include "../include/variables/022-HashMember-4.h"
+#include "../include/variables/023-value-lookups.h"
 //#include "../include/variables/.h"
 //#include "../include/variables/.h"
 //#include "../include/variables/.h"
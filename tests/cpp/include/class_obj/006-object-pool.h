@@ -0,0 +1,75 @@
+/**
+ *
+ *  Test Classes and objects
+ *	006-object-pool.phpt
+ *	test recycling of objects
+ *
+ */
+
+
+
+
+/**
+ *  Set up namespace
+ */
+namespace TestBaseClass {
+
+
+    /**
+     *  A class that counts how often it is constructed and reset
+     */
+    class Recyclable : public Php::Base
+    {
+    private:
+        /**
+         *  The per-instance state
+         *  @var    int
+         */
+        int _value = 0;
+
+    public:
+        /**
+         *  C++ constructor and destructor
+         */
+        Recyclable() { constructed()++; }
+        virtual ~Recyclable() {}
+
+        /**
+         *  Counters that are shared by all instances
+         *  @return int
+         */
+        static int &constructed() { static int counter = 0; return counter; }
+        static int &resets() { static int counter = 0; return counter; }
+
+        /**
+         *  Clear the state when the object is put in the pool
+         */
+        void __reset()
+        {
+            _value = 0;
+            resets()++;
+        }
+
+        /**
+         *  Methods to access the state
+         *  @param  params
+         *  @return Php::Value
+         */
+        void set(Php::Parameters &params) { _value = params[0]; }
+        Php::Value get() { return _value; }
+
+        /**
+         *  Static methods to retrieve the counters
+         *  @return Php::Value
+         */
+        static Php::Value numConstructed() { return constructed(); }
+        static Php::Value numResets() { return resets(); }
+    };
+
+
+
+/**
+ *  End of namespace
+ */
+}
+
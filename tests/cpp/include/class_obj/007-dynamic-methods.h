@@ -0,0 +1,63 @@
+/**
+ *
+ *  Test Classes and objects
+ *	007-dynamic-methods.phpt
+ *	test __call() and __callStatic() dispatching
+ *
+ */
+
+
+
+
+/**
+ *  Set up namespace
+ */
+namespace TestBaseClass {
+
+
+    /**
+     *  A class that implements all its methods with __call() and __callStatic()
+     */
+    class DynamicMethods : public Php::Base
+    {
+    public:
+        /**
+         *  C++ constructor and destructor
+         */
+        DynamicMethods() {}
+        virtual ~DynamicMethods() {}
+
+        /**
+         *  Regular method call
+         *  @param  name        Name of the method
+         *  @param  params      Parameters passed to the method
+         *  @return Php::Value
+         */
+        Php::Value __call(const char *name, Php::Parameters &params)
+        {
+            std::string result = std::string("__call ") + name;
+            for (auto &param : params) result += " " + param.stringValue();
+            return result;
+        }
+
+        /**
+         *  Static method call
+         *  @param  name        Name of the method
+         *  @param  params      Parameters passed to the method
+         *  @return Php::Value
+         */
+        static Php::Value __callStatic(const char *name, Php::Parameters &params)
+        {
+            std::string result = std::string("__callStatic ") + name;
+            for (auto &param : params) result += " " + param.stringValue();
+            return result;
+        }
+    };
+
+
+
+/**
+ *  End of namespace
+ */
+}
+
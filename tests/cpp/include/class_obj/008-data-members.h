@@ -0,0 +1,75 @@
+/**
+ *
+ *  Test Classes and objects
+ *	008-data-members.phpt
+ *	test properties that are bound to data members
+ *
+ */
+
+
+
+
+/**
+ *  Set up namespace
+ */
+namespace TestBaseClass {
+
+
+    /**
+     *  A class with plain data members that are accessible from PHP
+     */
+    class DataMembers : public Php::Base
+    {
+    public:
+        /**
+         *  The members
+         */
+        double x = 1.5;
+        int64_t y = -2;
+        uint8_t small = 200;
+        uint64_t big = 18446744073709551615ULL;
+        bool visible = true;
+        std::string label = "point";
+        const int32_t version = 3;
+
+        /**
+         *  C++ constructor and destructor
+         */
+        DataMembers() {}
+        virtual ~DataMembers() {}
+
+        /**
+         *  Dump the members as seen from C++
+         *  @return Php::Value
+         */
+        Php::Value dump()
+        {
+            return std::to_string(x) + " " + std::to_string(y) + " " + std::to_string(small) + " " + (visible ? "true" : "false") + " " + label;
+        }
+    };
+
+    /**
+     *  A native class that extends the class with data members
+     */
+    class DataMembersChild : public DataMembers
+    {
+    public:
+        /**
+         *  Additional member
+         */
+        double z = 9.5;
+
+        /**
+         *  C++ constructor and destructor
+         */
+        DataMembersChild() {}
+        virtual ~DataMembersChild() {}
+    };
+
+
+
+/**
+ *  End of namespace
+ */
+}
+
@@ -0,0 +1,97 @@
+/**
+ *
+ *  Test Classes and objects
+ *	010-stream-serializable.phpt
+ *	test serializing with an encoder and a decoder
+ *
+ */
+
+
+
+
+/**
+ *  Set up namespace
+ */
+namespace TestBaseClass {
+
+
+    /**
+     *  A class that writes its state in binary format
+     */
+    class StreamSerializable : public Php::Base, public Php::StreamSerializable
+    {
+    private:
+        /**
+         *  The state of the object
+         */
+        int64_t _number = 0;
+        double _ratio = 0.0;
+        std::string _name;
+        Php::Value _extra;
+
+    public:
+        /**
+         *  C++ constructor and destructor
+         */
+        StreamSerializable() {}
+        virtual ~StreamSerializable() {}
+
+        /**
+         *  Fill the object
+         *  @param  params      Number, ratio, name and extra data
+         */
+        void __construct(Php::Parameters &params)
+        {
+            _number = params[0];
+            _ratio = params[1];
+            _name = params[2].stringValue();
+            _extra = params[3];
+        }
+
+        /**
+         *  Describe the object
+         *  @return Php::Value
+         */
+        Php::Value describe()
+        {
+            return std::to_string(_number) + " " + std::to_string(_ratio) + " " + _name;
+        }
+
+        /**
+         *  The extra data
+         *  @return Php::Value
+         */
+        Php::Value extra()
+        {
+            return _extra;
+        }
+
+        /**
+         *  Write the object into the encoder
+         *  @param  encoder
+         */
+        virtual void serialize(Php::Encoder &encoder) override
+        {
+            encoder.writeInteger(_number).writeDouble(_ratio).writeString(_name).writeValue(_extra);
+        }
+
+        /**
+         *  Read the object from the decoder
+         *  @param  decoder
+         */
+        virtual void unserialize(Php::Decoder &decoder) override
+        {
+            _number = decoder.readInteger();
+            _ratio = decoder.readDouble();
+            _name = decoder.readString();
+            _extra = decoder.readValue();
+        }
+    };
+
+
+
+/**
+ *  End of namespace
+ */
+}
+
@@ -0,0 +1,103 @@
+/**
+ *
+ *  Test Classes and objects
+ *	012-index-access.phpt
+ *	test accessing an object with integer offsets
+ *
+ */
+
+
+
+
+/**
+ *  Set up namespace
+ */
+namespace TestBaseClass {
+
+
+    /**
+     *  A vector of numbers that can be accessed like an array
+     */
+    class IndexVector : public Php::Base, public Php::IndexAccess, public Php::Countable
+    {
+    private:
+        /**
+         *  The numbers
+         */
+        std::vector<double> _numbers;
+
+    public:
+        /**
+         *  C++ constructor and destructor
+         */
+        IndexVector() {}
+        virtual ~IndexVector() {}
+
+        /**
+         *  Check if an index exists
+         *  @param  index
+         *  @return bool
+         */
+        virtual bool indexExists(int64_t index) override
+        {
+            return index >= 0 && index < (int64_t)_numbers.size();
+        }
+
+        /**
+         *  Retrieve an element
+         *  @param  index
+         *  @return Php::Value
+         */
+        virtual Php::Value indexGet(int64_t index) override
+        {
+            if (!indexExists(index)) throw Php::Exception("Index out of range");
+            return _numbers[index];
+        }
+
+        /**
+         *  Assign an element
+         *  @param  index
+         *  @param  value
+         */
+        virtual void indexSet(int64_t index, const Php::Value &value) override
+        {
+            if (index < 0) throw Php::Exception("Index out of range");
+            if (index >= (int64_t)_numbers.size()) _numbers.resize(index + 1);
+            _numbers[index] = value.floatValue();
+        }
+
+        /**
+         *  Remove an element, the elements that follow are moved
+         *  @param  index
+         */
+        virtual void indexUnset(int64_t index) override
+        {
+            if (indexExists(index)) _numbers.erase(_numbers.begin() + index);
+        }
+
+        /**
+         *  Append an element
+         *  @param  value
+         */
+        virtual void indexAppend(const Php::Value &value) override
+        {
+            _numbers.push_back(value.floatValue());
+        }
+
+        /**
+         *  Number of elements
+         *  @return long
+         */
+        virtual long count() override
+        {
+            return _numbers.size();
+        }
+    };
+
+
+
+/**
+ *  End of namespace
+ */
+}
+
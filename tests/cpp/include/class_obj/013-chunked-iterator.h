@@ -0,0 +1,112 @@
+/**
+ *
+ *  Test Classes and objects
+ *	013-chunked-iterator.phpt
+ *	test iterating over an object in blocks of elements
+ *
+ */
+
+
+
+
+/**
+ *  Set up namespace
+ */
+namespace TestBaseClass {
+
+
+    /**
+     *  Iterator that returns the squares of a range of numbers, three at a time
+     */
+    class SquaresIterator : public Php::ChunkedIterator
+    {
+    private:
+        /**
+         *  Number of elements, and the next element to fetch
+         */
+        int64_t _size;
+        int64_t _next = 0;
+
+    public:
+        /**
+         *  Constructor
+         *  @param  base        The object over which we iterate
+         *  @param  size        Number of elements
+         *  @param  sequential  Use the position as key?
+         */
+        SquaresIterator(Php::Base *base, int64_t size, bool sequential) : 
+            Php::ChunkedIterator(base, sequential, 3), _size(size) {}
+
+        /**
+         *  Fetch the next block of elements
+         *  @param  values
+         *  @param  keys
+         *  @param  count
+         *  @return size_t
+         */
+        virtual size_t fetch(Php::Value *values, Php::Value *keys, size_t count) override
+        {
+            size_t fetched = 0;
+            for (; fetched < count && _next < _size; fetched++, _next++)
+            {
+                values[fetched] = _next * _next;
+                if (keys) keys[fetched] = "key" + std::to_string(_next);
+            }
+            return fetched;
+        }
+
+        /**
+         *  Start from the beginning
+         */
+        virtual void reset() override
+        {
+            _next = 0;
+        }
+    };
+
+    /**
+     *  Class that can be iterated over
+     */
+    class Squares : public Php::Base, public Php::Traversable
+    {
+    private:
+        /**
+         *  Number of elements and the type of keys
+         */
+        int64_t _size = 0;
+        bool _sequential = true;
+
+    public:
+        /**
+         *  C++ constructor and destructor
+         */
+        Squares() {}
+        virtual ~Squares() {}
+
+        /**
+         *  Set the number of elements
+         *  @param  params      Size, and whether the keys are sequential
+         */
+        void __construct(Php::Parameters &params)
+        {
+            _size = params[0];
+            if (params.size() > 1) _sequential = params[1];
+        }
+
+        /**
+         *  Retrieve the iterator
+         *  @return Php::Iterator
+         */
+        virtual Php::Iterator *getIterator() override
+        {
+            return new SquaresIterator(this, _size, _sequential);
+        }
+    };
+
+
+
+/**
+ *  End of namespace
+ */
+}
+
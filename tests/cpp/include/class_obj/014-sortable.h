@@ -0,0 +1,86 @@
+/**
+ *
+ *  Test Classes and objects
+ *	014-sortable.phpt
+ *	test sorting objects by their native sort key
+ *
+ */
+
+
+
+
+/**
+ *  Set up namespace
+ */
+namespace TestBaseClass {
+
+
+    /**
+     *  An order that is sorted by its amount
+     */
+    class Order : public Php::Base, public Php::Sortable
+    {
+    private:
+        /**
+         *  Name and amount of the order
+         */
+        std::string _name;
+        Php::Value _amount = 0.0;
+
+    public:
+        /**
+         *  C++ constructor and destructor
+         */
+        Order() {}
+        virtual ~Order() {}
+
+        /**
+         *  Fill the order
+         *  @param  params      Name and amount
+         */
+        void __construct(Php::Parameters &params)
+        {
+            _name = params[0].stringValue();
+            _amount = params[1];
+        }
+
+        /**
+         *  Name of the order
+         *  @return Php::Value
+         */
+        Php::Value name()
+        {
+            return _name;
+        }
+
+        /**
+         *  The key by which orders are sorted
+         *  @return Php::SortKey
+         */
+        virtual Php::SortKey sortKey() const override
+        {
+            // integer amounts keep their full precision
+            if (_amount.isFloat()) return _amount.floatValue();
+            return _amount.numericValue();
+        }
+
+        /**
+         *  Sort an array of orders
+         *  @param  params      The array, and whether to sort descending
+         *  @return Php::Value  The sorted array, or false
+         */
+        static Php::Value sortAll(Php::Parameters &params)
+        {
+            Php::Value orders = params[0];
+            if (!Php::sort(orders, params.size() > 1 && params[1].boolValue())) return false;
+            return orders;
+        }
+    };
+
+
+
+/**
+ *  End of namespace
+ */
+}
+
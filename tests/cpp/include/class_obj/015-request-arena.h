@@ -0,0 +1,129 @@
+/**
+ *
+ *  Test Classes and objects
+ *	015-request-arena.phpt
+ *	test allocating temporary data from the request arena
+ *
+ */
+
+
+
+
+/**
+ *  Set up namespace
+ */
+namespace TestBaseClass {
+
+
+    /**
+     *  Class with a method that builds temporary data in the request arena
+     */
+    class ArenaUser : public Php::Base
+    {
+    public:
+        /**
+         *  Build a vector of numbers, and return their sum
+         *  @param  params      Number of elements
+         *  @return Php::Value
+         */
+        static Php::Value build(Php::Parameters &params)
+        {
+            std::vector<int64_t, Php::ArenaAllocator<int64_t>> numbers;
+            for (int64_t i = 0; i < params[0].numericValue(); i++) numbers.push_back(i);
+
+            int64_t sum = 0;
+            for (auto number : numbers) sum += number;
+            return sum;
+        }
+
+        /**
+         *  Try to allocate an array whose size overflows
+         *  @return Php::Value  Whether the allocation was refused
+         */
+        static Php::Value overflow()
+        {
+            try
+            {
+                Php::RequestArena::allocate<int64_t>(SIZE_MAX / 4);
+                return false;
+            }
+            catch (const std::bad_alloc &exception)
+            {
+                return true;
+            }
+        }
+
+        /**
+         *  Retrieve the arena counters
+         *  @return Php::Value
+         */
+        static Php::Value statistics()
+        {
+            Php::ArenaStatistics statistics = Php::RequestArena::statistics();
+
+            Php::Value result;
+            result["used"] = (int64_t)statistics.used;
+            result["reserved"] = (int64_t)statistics.reserved;
+            result["peak"] = (int64_t)statistics.peakUsed;
+            return result;
+        }
+    };
+
+    /**
+     *  Class with a container in the request arena, that lives as long as
+     *  the object
+     */
+    class ArenaHolder : public Php::Base
+    {
+    private:
+        /**
+         *  The numbers
+         *  @var    std::vector
+         */
+        std::vector<int64_t, Php::ArenaAllocator<int64_t>> _numbers;
+
+    public:
+        /**
+         *  C++ constructor
+         */
+        ArenaHolder() {}
+
+        /**
+         *  C++ destructor, this also runs for objects that are only destructed
+         *  when the engine cleans up, and it still reads the arena memory
+         */
+        virtual ~ArenaHolder()
+        {
+            int64_t sum = 0;
+            for (auto number : _numbers) sum += number;
+            if (sum != (int64_t)_numbers.size() * ((int64_t)_numbers.size() - 1) / 2) std::cerr << "arena memory was released too early" << std::endl;
+        }
+
+        /**
+         *  PHP constructor
+         *  @param  params      Number of elements
+         */
+        void __construct(Php::Parameters &params)
+        {
+            for (int64_t i = 0; i < params[0].numericValue(); i++) _numbers.push_back(i);
+        }
+
+        /**
+         *  Sum of the numbers
+         *  @return Php::Value
+         */
+        Php::Value sum()
+        {
+            int64_t sum = 0;
+            for (auto number : _numbers) sum += number;
+            return sum;
+        }
+    };
+
+
+
+/**
+ *  End of namespace
+ */
+}
+
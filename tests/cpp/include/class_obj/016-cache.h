@@ -0,0 +1,107 @@
+/**
+ *
+ *  Test Classes and objects
+ *	016-cache.phpt
+ *	test storing values in a persistent cache
+ *
+ */
+
+
+
+
+/**
+ *  Set up namespace
+ */
+namespace TestBaseClass {
+
+
+    /**
+     *  Class with static methods to access a cache
+     */
+    class CacheUser : public Php::Base
+    {
+    private:
+        /**
+         *  The cache, it lives as long as the process
+         *  @return Php::Cache
+         */
+        static Php::Cache &cache()
+        {
+            static Php::Cache cache(1024 * 1024, 4);
+            return cache;
+        }
+
+    public:
+        /**
+         *  Store a value
+         *  @param  params      Key and value
+         *  @return Php::Value
+         */
+        static Php::Value set(Php::Parameters &params)
+        {
+            return cache().set(params[0], params[1]);
+        }
+
+        /**
+         *  Retrieve a value
+         *  @param  params      Key
+         *  @return Php::Value
+         */
+        static Php::Value get(Php::Parameters &params)
+        {
+            return cache().get(params[0]);
+        }
+
+        /**
+         *  Remove a value
+         *  @param  params      Key
+         *  @return Php::Value
+         */
+        static Php::Value remove(Php::Parameters &params)
+        {
+            return cache().remove(params[0]);
+        }
+
+        /**
+         *  Mix up PHP values and C++ objects of type Php::Value
+         *  @return Php::Value  Whether both lookups failed
+         */
+        static Php::Value mixed()
+        {
+            // a C++ object is not returned as PHP value
+            cache().setObject("object", std::make_shared<Php::Value>(12), 64);
+            bool object = cache().get("object").isNull();
+
+            // and a PHP value is not returned as C++ object
+            cache().set("value", 12);
+            bool value = !cache().getObject<Php::Value>("value");
+
+            // clean up
+            cache().remove("object");
+            cache().remove("value");
+            return object && value;
+        }
+
+        /**
+         *  Retrieve the counters
+         *  @return Php::Value
+         */
+        static Php::Value statistics()
+        {
+            Php::CacheStatistics statistics = cache().statistics();
+
+            Php::Value result;
+            result["entries"] = (int64_t)statistics.entries;
+            result["hits"] = (int64_t)statistics.hits;
+            result["misses"] = (int64_t)statistics.misses;
+            return result;
+        }
+    };
+
+
+
+/**
+ *  End of namespace
+ */
+}
+
@@ -0,0 +1,100 @@
+/**
+ *
+ *  Test Classes and objects
+ *	017-shared-cache.phpt
+ *	test storing values in a shared memory cache
+ *
+ */
+
+
+
+
+/**
+ *  Set up namespace
+ */
+namespace TestBaseClass {
+
+
+    /**
+     *  Class with static methods to access a shared memory cache
+     */
+    class SharedCacheUser : public Php::Base
+    {
+    private:
+        /**
+         *  The cache, it is created in the onStartup() callback
+         *  @return std::unique_ptr
+         */
+        static std::unique_ptr<Php::SharedCache> &instance()
+        {
+            static std::unique_ptr<Php::SharedCache> cache;
+            return cache;
+        }
+
+        /**
+         *  The cache
+         *  @return Php::SharedCache
+         */
+        static Php::SharedCache &cache()
+        {
+            // the cache is only missing if onStartup() was not called
+            if (!instance()) throw Php::Exception("Shared cache was not created on startup");
+            return *instance();
+        }
+
+    public:
+        /**
+         *  Create the cache, before the worker processes are forked
+         */
+        static void startup()
+        {
+            instance().reset(new Php::SharedCache(4 * 1024 * 1024, 1024));
+        }
+
+        /**
+         *  Store a value
+         *  @param  params      Key and value
+         *  @return Php::Value
+         */
+        static Php::Value set(Php::Parameters &params)
+        {
+            return cache().set(params[0], params[1]);
+        }
+
+        /**
+         *  Retrieve a value
+         *  @param  params      Key
+         *  @return Php::Value
+         */
+        static Php::Value get(Php::Parameters &params)
+        {
+            return cache().get(params[0]);
+        }
+
+        /**
+         *  Remove a value
+         *  @param  params      Key
+         *  @return Php::Value
+         */
+        static Php::Value remove(Php::Parameters &params)
+        {
+            return cache().remove(params[0]);
+        }
+
+        /**
+         *  Retrieve the number of entries
+         *  @return Php::Value
+         */
+        static Php::Value entries()
+        {
+            return (int64_t)cache().statistics().entries;
+        }
+    };
+
+
+
+/**
+ *  End of namespace
+ */
+}
+
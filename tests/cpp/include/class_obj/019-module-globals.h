@@ -0,0 +1,67 @@
+/**
+ *
+ *  Test Classes and objects
+ *	019-module-globals.phpt
+ *	test state that is stored in module globals
+ *
+ */
+
+
+
+
+/**
+ *  Set up namespace
+ */
+namespace TestBaseClass {
+
+
+    /**
+     *  The state that is kept per thread
+     */
+    struct CounterState
+    {
+        int64_t counter = 0;
+    };
+
+    /**
+     *  Class with methods that use the state
+     */
+    class Counter : public Php::Base
+    {
+    public:
+        /**
+         *  The state that is reset after each request
+         */
+        static Php::ModuleGlobals<CounterState> request;
+
+        /**
+         *  The state that is kept for as long as the thread runs
+         */
+        static Php::ModuleGlobals<CounterState> thread;
+
+        /**
+         *  Increment the counters
+         *  @return Php::Value
+         */
+        static Php::Value increment()
+        {
+            Php::Value result;
+            result["request"] = ++request->counter;
+            result["thread"] = ++thread->counter;
+            return result;
+        }
+    };
+
+    /**
+     *  Definition of the globals
+     */
+    Php::ModuleGlobals<CounterState> Counter::request;
+    Php::ModuleGlobals<CounterState> Counter::thread(Php::Lifetime::Thread);
+
+
+
+/**
+ *  End of namespace
+ */
+}
+
@@ -0,0 +1,110 @@
+/**
+ *
+ *  Test Classes and objects
+ *	020-worker-pool.phpt
+ *	test tasks that run in the background threads
+ *
+ */
+
+
+
+
+/**
+ *  Set up namespace
+ */
+namespace TestBaseClass {
+
+
+    /**
+     *  Class with a method that splits its work over multiple tasks
+     */
+    class ParallelSum : public Php::Base
+    {
+    public:
+        /**
+         *  Sum the squares of the numbers in an array
+         *  @param  params
+         *  @return Php::Value
+         */
+        static Php::Value squares(Php::Parameters &params)
+        {
+            // copy the numbers out of the php array
+            auto numbers = std::make_shared<std::vector<int64_t>>();
+            for (auto &iter : params[0]) numbers->push_back(iter.second.numericValue());
+
+            // the running tasks
+            std::vector<std::future<int64_t>> tasks;
+
+            // split into four parts
+            size_t size = numbers->size();
+            for (size_t part = 0; part < 4; part++)
+            {
+                size_t begin = size * part / 4, end = size * (part + 1) / 4;
+                tasks.push_back(Php::WorkerPool::submit([numbers, begin, end]() {
+                    int64_t result = 0;
+                    for (size_t i = begin; i < end; i++) result += (*numbers)[i] * (*numbers)[i];
+                    return result;
+                }));
+            }
+
+            // join the tasks on the request thread
+            int64_t result = 0;
+            for (auto &task : tasks) result += task.get();
+            return result;
+        }
+
+        /**
+         *  Run tasks that split themselves into more tasks, and wait for them
+         *  @return Php::Value
+         */
+        static Php::Value nested()
+        {
+            // the running tasks
+            std::vector<std::future<int64_t>> tasks;
+
+            // many more tasks than threads, each of them waits for its parts
+            for (int64_t task = 0; task < 64; task++)
+            {
+                tasks.push_back(Php::WorkerPool::submit([task]() {
+                    std::vector<std::future<int64_t>> parts;
+                    for (int64_t part = 0; part < 8; part++) parts.push_back(Php::WorkerPool::submit([task, part]() { return task * 8 + part; }));
+                    int64_t result = 0;
+                    for (auto &part : parts) result += part.get();
+                    return result;
+                }));
+            }
+
+            // join the tasks on the request thread
+            int64_t result = 0;
+            for (auto &task : tasks) result += task.get();
+            return result;
+        }
+
+        /**
+         *  Run a task that throws
+         *  @return Php::Value
+         */
+        static Php::Value failure()
+        {
+            // start the task
+            auto task = Php::WorkerPool::submit([]() -> int64_t { throw std::runtime_error("task failed"); });
+
+            // the exception is rethrown when the result is joined
+            try
+            {
+                return task.get();
+            }
+            catch (const std::exception &exception)
+            {
+                return exception.what();
+            }
+        }
+    };
+
+
+
+/**
+ *  End of namespace
+ */
+}
+
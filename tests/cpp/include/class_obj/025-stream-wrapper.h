@@ -0,0 +1,100 @@
+/**
+ *
+ *  Test Classes and objects
+ *	025-stream-wrapper.phpt
+ *	test a stream wrapper that keeps files in memory
+ *
+ */
+
+
+
+
+/**
+ *  Set up namespace
+ */
+namespace TestBaseClass {
+
+
+    /**
+     *  The files of the wrapper
+     */
+    using MemoryFiles = std::map<std::string, std::shared_ptr<const std::string>>;
+
+    /**
+     *  Stream that collects the written data, and stores it when it is closed
+     */
+    class MemoryWriter : public Php::Stream
+    {
+    private:
+        MemoryFiles &_files;
+        std::string _path;
+        std::string _data;
+
+    public:
+        MemoryWriter(MemoryFiles &files, const char *path) : _files(files), _path(path) {}
+
+        virtual ~MemoryWriter()
+        {
+            _files[_path] = std::make_shared<const std::string>(std::move(_data));
+        }
+
+        virtual size_t write(const char *data, size_t size) override
+        {
+            _data.append(data, size);
+            return size;
+        }
+    };
+
+    /**
+     *  Wrapper for the "phpcpp://" protocol, urls that start with
+     *  "phpcpp://file/" are mapped to local files
+     */
+    class MemoryWrapper : public Php::StreamWrapper
+    {
+    private:
+        MemoryFiles _files;
+
+    public:
+        MemoryWrapper() : Php::StreamWrapper("phpcpp") {}
+
+        virtual Php::Stream *open(const char *path, const char *mode) override
+        {
+            // local files are mapped into memory
+            if (strncmp(path, "phpcpp://file/", 14) == 0)
+            {
+                auto *stream = new Php::MappedFileStream(path + 13);
+                if (stream->valid()) return stream;
+                delete stream;
+                throw Php::Exception("no such file");
+            }
+
+            // new files are stored when they are closed
+            if (mode[0] == 'w') return new MemoryWriter(_files, path);
+
+            // existing files are shared with the stream
+            auto iter = _files.find(path);
+            if (iter == _files.end()) return nullptr;
+            return new Php::BufferStream(iter->second);
+        }
+
+        virtual bool stat(const char *path, Php::StreamStat &stat) override
+        {
+            auto iter = _files.find(path);
+            if (iter == _files.end()) return false;
+            stat.size = iter->second->size();
+            return true;
+        }
+
+        virtual bool unlink(const char *path) override
+        {
+            return _files.erase(path) > 0;
+        }
+    };
+
+
+
+/**
+ *  End of namespace
+ */
+}
+
@@ -0,0 +1,74 @@
+/**
+ *
+ *  Test Classes and objects
+ *	026-input-stream.phpt
+ *	test reading PHP streams with a Php::InputStream
+ *
+ */
+
+
+
+
+/**
+ *  Set up namespace
+ */
+namespace TestBaseClass {
+
+
+    /**
+     *  Class with methods that read from a stream
+     */
+    class InputReader : public Php::Base
+    {
+    public:
+        /**
+         *  The lines of a stream
+         *  @param  params
+         *  @return Php::Value
+         */
+        static Php::Value lines(Php::Parameters &params)
+        {
+            Php::InputStream input(params[0]);
+            Php::Value result;
+            std::string line;
+            int index = 0;
+            while (input.getline(line)) result[index++] = line;
+            return result;
+        }
+
+        /**
+         *  The number of bytes in a stream
+         *  @param  params
+         *  @return Php::Value
+         */
+        static Php::Value size(Php::Parameters &params)
+        {
+            Php::InputStream input(params[0]);
+            std::vector<char> buffer(100000);
+            int64_t total = 0;
+            size_t size;
+            while ((size = input.read(buffer.data(), buffer.size())) > 0) total += size;
+            return total;
+        }
+
+        /**
+         *  The sum of the numbers in a stream
+         *  @param  params
+         *  @return Php::Value
+         */
+        static Php::Value sum(Php::Parameters &params)
+        {
+            Php::InputStream input(params[0]);
+            double value, total = 0.0;
+            while (input.istream() >> value) total += value;
+            return total;
+        }
+    };
+
+
+
+/**
+ *  End of namespace
+ */
+}
+
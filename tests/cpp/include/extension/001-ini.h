@@ -0,0 +1,72 @@
+/**
+ *
+ *  Test extension features
+ *	001-ini.phpt
+ *	test php.ini settings that are bound to variables
+ *
+ */
+
+
+
+
+/**
+ *  Set up namespace
+ */
+namespace TestExtension {
+
+
+    /**
+     *  Class that holds the settings
+     */
+    class IniSettings : public Php::Base
+    {
+    public:
+        /**
+         *  The variables that are bound to the settings
+         */
+        static int64_t number;
+        static double ratio;
+        static bool enabled;
+        static std::string name;
+        static size_t size;
+
+        /**
+         *  Settings that have a separate value for each thread
+         */
+        struct Settings { int64_t limit = 0; };
+        static Php::ModuleGlobals<Settings> settings;
+
+        /**
+         *  Retrieve the values of the variables
+         *  @return Php::Value
+         */
+        static Php::Value values()
+        {
+            Php::Value result;
+            result["number"] = number;
+            result["ratio"] = ratio;
+            result["enabled"] = enabled;
+            result["name"] = name;
+            result["size"] = (int64_t)size;
+            result["limit"] = settings->limit;
+            return result;
+        }
+    };
+
+    /**
+     *  Definition of the variables
+     */
+    int64_t IniSettings::number = 0;
+    double IniSettings::ratio = 0.0;
+    bool IniSettings::enabled = false;
+    std::string IniSettings::name;
+    size_t IniSettings::size = 0;
+    Php::ModuleGlobals<IniSettings::Settings> IniSettings::settings(Php::Lifetime::Thread);
+
+
+
+/**
+ *  End of namespace
+ */
+}
+
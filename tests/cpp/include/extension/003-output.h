@@ -0,0 +1,59 @@
+/**
+ *
+ *  Test extension features
+ *	003-output.phpt
+ *	test output that is written to Php::out
+ *
+ */
+
+
+
+
+/**
+ *  Set up namespace
+ */
+namespace TestExtension {
+
+
+    /**
+     *  Class with methods that write output
+     */
+    class Output : public Php::Base
+    {
+    public:
+        /**
+         *  Write a number of small pieces
+         *  @param  params
+         */
+        static void pieces(Php::Parameters &params)
+        {
+            for (int64_t i = 0; i < params[0].numericValue(); i++) Php::out << i << ",";
+        }
+
+        /**
+         *  Write a big string
+         *  @param  params
+         */
+        static void block(Php::Parameters &params)
+        {
+            Php::out << std::string(params[0].numericValue(), 'x') << params[1];
+        }
+
+        /**
+         *  Write a value in a field of a fixed width
+         *  @param  params
+         */
+        static void padded(Php::Parameters &params)
+        {
+            Php::out.width(params[1].numericValue());
+            Php::out << params[0];
+        }
+    };
+
+
+
+/**
+ *  End of namespace
+ */
+}
+
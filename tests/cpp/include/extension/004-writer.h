@@ -0,0 +1,56 @@
+/**
+ *
+ *  Test extension features
+ *	004-writer.phpt, 005-writer-locale.phpt
+ *	test output that is written with a Php::Writer
+ *
+ */
+
+
+
+
+/**
+ *  Set up namespace
+ */
+namespace TestExtension {
+
+
+    /**
+     *  Class with methods that write output
+     */
+    class Templates : public Php::Base
+    {
+    public:
+        /**
+         *  Write the elements of an array as html table rows
+         *  @param  params
+         */
+        static void rows(Php::Parameters &params)
+        {
+            Php::Writer writer;
+            for (auto &iter : params[0])
+            {
+                writer << "<tr><td>" << iter.first.numericValue() << "</td><td>";
+                writer.html(iter.second).write("</td></tr>\n");
+            }
+        }
+
+        /**
+         *  Write a json object with a string and a number
+         *  @param  params
+         */
+        static void json(Php::Parameters &params)
+        {
+            Php::Writer writer;
+            writer << "{\"name\":\"";
+            writer.json(params[0]) << "\",\"value\":" << params[1].floatValue() << "}\n";
+        }
+    };
+
+
+
+/**
+ *  End of namespace
+ */
+}
+
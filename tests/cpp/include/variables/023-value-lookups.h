@@ -0,0 +1,42 @@
+/**
+ *
+ *  Test variables
+ *	023-value-lookups.phpt
+ *
+ *	The function is also used by the microbenchmark in tests/php/bench, on a
+ *	thread safe PHP build every lookup needs the tsrm_ls pointer
+ *
+ */
+
+
+namespace TestVariables {
+
+
+	/*
+	 * Look up all elements of an array a number of times
+	 * @param  params      The array and the number of rounds
+	 * @return Php::Value  Number of elements that were found
+	 */
+	Php::Value value_lookups(Php::Parameters &params)
+	{
+		Php::Value array = params[0];
+		int64_t rounds = params[1];
+		int64_t found = 0;
+
+		for (int64_t round = 0; round < rounds; round++)
+		{
+			int size = array.size();
+			for (int i = 0; i < size; i++)
+			{
+				if (array.contains(i) && array.get(i).isNumeric()) found++;
+			}
+		}
+
+		return found;
+	}
+
+/**
+ *  End of namespace
+ */
+}
+
@@ -11,6 +11,7 @@
 #include "h/ValueIterator.h"
 #include "h/Classes_and_objects.h"
 #include "h/variables.h"
+#include "h/extension.h"
 
 
 
@@ -83,6 +84,154 @@ extern "C"
         // C++ methods as regular global PHP functions
         extension.add("TestBaseClass\\staticFun1", &TestBaseClass::testStaticPrivClass::staticMethod);
 
+        // test recycling of objects
+        Php::Class<TestBaseClass::Recyclable> recyclable("TestBaseClass\\Recyclable");
+        recyclable.method("get", &TestBaseClass::Recyclable::get);
+        recyclable.method("set", &TestBaseClass::Recyclable::set);
+        recyclable.method("numConstructed", &TestBaseClass::Recyclable::numConstructed);
+        recyclable.method("numResets", &TestBaseClass::Recyclable::numResets);
+        recyclable.pool(4);
+        extension.add(std::move(recyclable));
+
+        // test __call() and __callStatic() dispatching
+        Php::Class<TestBaseClass::DynamicMethods> dynamicMethods("TestBaseClass\\DynamicMethods");
+        dynamicMethods.dynamicMethod("registered");
+        dynamicMethods.dynamicMethod("registeredStatic", Php::Public | Php::Static);
+        extension.add(std::move(dynamicMethods));
+
+        // test properties that are bound to data members
+        Php::Class<TestBaseClass::DataMembers> dataMembers("TestBaseClass\\DataMembers");
+        dataMembers.property("x", &TestBaseClass::DataMembers::x);
+        dataMembers.property("y", &TestBaseClass::DataMembers::y);
+        dataMembers.property("small", &TestBaseClass::DataMembers::small);
+        dataMembers.property("big", &TestBaseClass::DataMembers::big);
+        dataMembers.property("visible", &TestBaseClass::DataMembers::visible);
+        dataMembers.property("label", &TestBaseClass::DataMembers::label);
+        dataMembers.property("version", &TestBaseClass::DataMembers::version);
+        dataMembers.method("dump", &TestBaseClass::DataMembers::dump);
+        
+        // a native class that inherits the bound properties
+        Php::Class<TestBaseClass::DataMembersChild> dataMembersChild("TestBaseClass\\DataMembersChild");
+        dataMembersChild.extends(dataMembers);
+        dataMembersChild.property("z", &TestBaseClass::DataMembersChild::z);
+        extension.add(std::move(dataMembers));
+        extension.add(std::move(dataMembersChild));
+
+        // test serializing with an encoder and a decoder
+        Php::Class<TestBaseClass::StreamSerializable> streamSerializable("TestBaseClass\\StreamSerializable");
+        streamSerializable.method("__construct", &TestBaseClass::StreamSerializable::__construct);
+        streamSerializable.method("describe", &TestBaseClass::StreamSerializable::describe);
+        streamSerializable.method("extra", &TestBaseClass::StreamSerializable::extra);
+        extension.add(std::move(streamSerializable));
+
+        // test accessing an object with integer offsets
+        extension.add(Php::Class<TestBaseClass::IndexVector>("TestBaseClass\\IndexVector"));
+
+        // test iterating over an object in blocks of elements
+        Php::Class<TestBaseClass::Squares> squares("TestBaseClass\\Squares");
+        squares.method("__construct", &TestBaseClass::Squares::__construct);
+        extension.add(std::move(squares));
+
+        // test sorting objects by their native sort key
+        Php::Class<TestBaseClass::Order> order("TestBaseClass\\Order");
+        order.method("__construct", &TestBaseClass::Order::__construct);
+        order.method("name", &TestBaseClass::Order::name);
+        order.method("sortAll", &TestBaseClass::Order::sortAll);
+        extension.add(std::move(order));
+
+        // test allocating temporary data from the request arena
+        Php::Class<TestBaseClass::ArenaUser> arenaUser("TestBaseClass\\ArenaUser");
+        arenaUser.method("build", &TestBaseClass::ArenaUser::build);
+        arenaUser.method("statistics", &TestBaseClass::ArenaUser::statistics);
+        arenaUser.method("overflow", &TestBaseClass::ArenaUser::overflow);
+        extension.add(std::move(arenaUser));
+        
+        // test objects that keep arena memory until the engine cleans up
+        Php::Class<TestBaseClass::ArenaHolder> arenaHolder("TestBaseClass\\ArenaHolder");
+        arenaHolder.method("__construct", &TestBaseClass::ArenaHolder::__construct);
+        arenaHolder.method("sum", &TestBaseClass::ArenaHolder::sum);
+        extension.add(std::move(arenaHolder));
+
+        // test storing values in a persistent cache
+        Php::Class<TestBaseClass::CacheUser> cacheUser("TestBaseClass\\CacheUser");
+        cacheUser.method("set", &TestBaseClass::CacheUser::set);
+        cacheUser.method("get", &TestBaseClass::CacheUser::get);
+        cacheUser.method("remove", &TestBaseClass::CacheUser::remove);
+        cacheUser.method("mixed", &TestBaseClass::CacheUser::mixed);
+        cacheUser.method("statistics", &TestBaseClass::CacheUser::statistics);
+        extension.add(std::move(cacheUser));
+
+        // test storing values in a shared memory cache
+        Php::Class<TestBaseClass::SharedCacheUser> sharedCacheUser("TestBaseClass\\SharedCacheUser");
+        sharedCacheUser.method("set", &TestBaseClass::SharedCacheUser::set);
+        sharedCacheUser.method("get", &TestBaseClass::SharedCacheUser::get);
+        sharedCacheUser.method("remove", &TestBaseClass::SharedCacheUser::remove);
+        sharedCacheUser.method("entries", &TestBaseClass::SharedCacheUser::entries);
+        extension.add(std::move(sharedCacheUser));
+        extension.onStartup(&TestBaseClass::SharedCacheUser::startup);
+
+        // test php.ini settings that are bound to variables
+        extension.add(Php::Ini("extension_for_tests.number", TestExtension::IniSettings::number, 10));
+        extension.add(Php::Ini("extension_for_tests.ratio", TestExtension::IniSettings::ratio, 0.25));
+        extension.add(Php::Ini("extension_for_tests.enabled", TestExtension::IniSettings::enabled, true));
+        extension.add(Php::Ini("extension_for_tests.name", TestExtension::IniSettings::name, "default"));
+        extension.add(Php::Ini("extension_for_tests.size", TestExtension::IniSettings::size, "1K"));
+        extension.add(Php::Ini("extension_for_tests.limit", TestExtension::IniSettings::settings, &TestExtension::IniSettings::Settings::limit, 5));
+        Php::Class<TestExtension::IniSettings> iniSettings("TestExtension\\IniSettings");
+        iniSettings.method("values", &TestExtension::IniSettings::values);
+        extension.add(std::move(iniSettings));
+        
+        // test classes with module globals
+        Php::Class<TestBaseClass::Counter> counter("TestBaseClass\\Counter");
+        counter.method("increment", &TestBaseClass::Counter::increment);
+        extension.add(std::move(counter));
+        
+        // test classes that use the worker pool
+        Php::Class<TestBaseClass::ParallelSum> parallelSum("TestBaseClass\\ParallelSum");
+        parallelSum.method("squares", &TestBaseClass::ParallelSum::squares);
+        parallelSum.method("failure", &TestBaseClass::ParallelSum::failure);
+        parallelSum.method("nested", &TestBaseClass::ParallelSum::nested);
+        extension.add(std::move(parallelSum));
+        
+        // test the numeric kernels
+        extension.add("TestExtension\\Kernels\\sum",        Php::Kernels::sum);
+        extension.add("TestExtension\\Kernels\\mean",       Php::Kernels::mean);
+        extension.add("TestExtension\\Kernels\\min",        Php::Kernels::min);
+        extension.add("TestExtension\\Kernels\\max",        Php::Kernels::max);
+        extension.add("TestExtension\\Kernels\\dot",        Php::Kernels::dot);
+        extension.add("TestExtension\\Kernels\\prefixSum",  Php::Kernels::prefixSum);
+        extension.add("TestExtension\\Kernels\\histogram",  Php::Kernels::histogram);
+        extension.add("TestExtension\\Kernels\\sort",       Php::Kernels::sort);
+        
+        // test the phpinfo() section
+        extension.instrument();
+        extension.onInfo([](Php::Info &info) {
+            info.row("Test row", "test value");
+        });
+        
+        // test classes that write output
+        Php::Class<TestExtension::Output> output("TestExtension\\Output");
+        output.method("pieces", &TestExtension::Output::pieces);
+        output.method("block", &TestExtension::Output::block);
+        output.method("padded", &TestExtension::Output::padded);
+        extension.add(std::move(output));
+        
+        // test classes that use a writer
+        Php::Class<TestExtension::Templates> templates("TestExtension\\Templates");
+        templates.method("rows", &TestExtension::Templates::rows);
+        templates.method("json", &TestExtension::Templates::json);
+        extension.add(std::move(templates));
+        
+        // test a stream wrapper
+        extension.add(std::make_shared<TestBaseClass::MemoryWrapper>());
+        
+        // test classes that read from a stream
+        Php::Class<TestBaseClass::InputReader> inputReader("TestBaseClass\\InputReader");
+        inputReader.method("lines", &TestBaseClass::InputReader::lines);
+        inputReader.method("size", &TestBaseClass::InputReader::size);
+        inputReader.method("sum", &TestBaseClass::InputReader::sum);
+        extension.add(std::move(inputReader));
+
 
 
 
@@ -119,6 +268,7 @@ extern "C"
         extension.add("TestVariables\\test_HashMember_2", TestVariables::test_HashMember_2);
         extension.add("TestVariables\\test_HashMember_3", TestVariables::test_HashMember_3);
         extension.add("TestVariables\\test_HashMember_4", TestVariables::test_HashMember_4);
+        extension.add("TestVariables\\value_lookups",     TestVariables::value_lookups);
 
         
 
@@ -0,0 +1,21 @@
+<?php
+
+/**
+ *  Microbenchmark for Php::Value::size(), contains() and get()
+ *
+ *  On a thread safe PHP build every lookup needs the tsrm_ls pointer of
+ *  the current thread, run it with a ZTS and a non-ZTS binary to compare
+ *  (see bench.sh)
+ */
+
+$array = range(1, 1000);
+$rounds = isset($argv[1]) ? (int)$argv[1] : 10000;
+
+// warm up
+TestVariables\value_lookups($array, 10);
+
+$start = microtime(true);
+$found = TestVariables\value_lookups($array, $rounds);
+$elapsed = microtime(true) - $start;
+
+printf("%s: %d lookups in %.3f seconds, %.1f ns per lookup\n", PHP_ZTS ? "zts" : "nts", $found, $elapsed, $elapsed * 1e9 / max($found, 1));
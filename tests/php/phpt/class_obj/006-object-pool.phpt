@@ -0,0 +1,24 @@
+--TEST--
+Test recycling of objects
+--SKIPIF--
+<?php if (!extension_loaded("extension_for_tests")) print "skip"; ?>
+--FILEEOF--
+<?php
+
+// create and destroy a number of objects, they should all come from the pool
+for ($i = 0; $i < 10; $i++)
+{
+    $object = new TestBaseClass\Recyclable();
+    echo $object->get(), " ";
+    $object->set($i + 1);
+    unset($object);
+}
+echo PHP_EOL;
+
+// only the first object was really constructed
+var_dump(TestBaseClass\Recyclable::numConstructed());
+var_dump(TestBaseClass\Recyclable::numResets());
+--EXPECT--
+0 0 0 0 0 0 0 0 0 0 
+int(1)
+int(10)
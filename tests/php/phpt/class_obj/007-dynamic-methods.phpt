@@ -0,0 +1,48 @@
+--TEST--
+Test __call() and __callStatic() dispatching
+--SKIPIF--
+<?php if (!extension_loaded("extension_for_tests")) print "skip"; ?>
+--FILEEOF--
+<?php
+
+$object = new TestBaseClass\DynamicMethods();
+
+// undefined methods are passed to __call(), repeated calls reuse the same record
+for ($i = 0; $i < 2; $i++) echo $object->someMethod($i), PHP_EOL;
+
+// dynamic names and callbacks
+$name = "otherMethod";
+echo $object->$name("x"), PHP_EOL;
+echo call_user_func(array($object, "viaCallback"), "y"), PHP_EOL;
+
+// methods that were registered up front
+echo $object->registered(1, 2), PHP_EOL;
+echo TestBaseClass\DynamicMethods::registeredStatic(3), PHP_EOL;
+
+// undefined static methods are passed to __callStatic()
+echo TestBaseClass\DynamicMethods::someStatic(4), PHP_EOL;
+echo TestBaseClass\DynamicMethods::someStatic(5), PHP_EOL;
+
+// static syntax in an instance context still reaches __call()
+class DynamicChild extends TestBaseClass\DynamicMethods
+{
+    public function viaParent() { return parent::fromChild(6); }
+}
+$child = new DynamicChild();
+echo $child->viaParent(), PHP_EOL;
+
+// many different names do not exhaust the cached records
+$count = 0;
+for ($i = 0; $i < 1000; $i++) if ($object->{"method$i"}() == "__call method$i") $count++;
+echo $count, PHP_EOL;
+--EXPECT--
+__call someMethod 0
+__call someMethod 1
+__call otherMethod x
+__call viaCallback y
+__call registered 1 2
+__callStatic registeredStatic 3
+__callStatic someStatic 4
+__callStatic someStatic 5
+__call fromChild 6
+1000
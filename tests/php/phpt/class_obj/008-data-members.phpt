@@ -0,0 +1,43 @@
+--TEST--
+Test properties that are bound to data members
+--SKIPIF--
+<?php if (!extension_loaded("extension_for_tests")) print "skip"; ?>
+--FILEEOF--
+<?php
+
+$object = new TestBaseClass\DataMembers();
+
+// read the initial values
+var_dump($object->x, $object->y, $object->small, $object->visible, $object->label, $object->version);
+
+// unsigned values above the highest integer become a float
+var_dump($object->big);
+
+// write new values, which are converted to the type of the member
+$object->x = 3;
+$object->y = "42";
+$object->small = 255;
+$object->visible = 0;
+$object->label = 12;
+echo $object->dump(), PHP_EOL;
+
+// bound properties always exist
+var_dump(isset($object->x));
+
+// a native subclass sees the properties of its base class
+$child = new TestBaseClass\DataMembersChild();
+$child->x = 7;
+var_dump($child->x, $child->z, $child->label);
+--EXPECT--
+float(1.5)
+int(-2)
+int(200)
+bool(true)
+string(5) "point"
+int(3)
+float(1.844674407371E+19)
+3.000000 42 255 false 12
+bool(true)
+float(7)
+float(9.5)
+string(5) "point"
@@ -0,0 +1,39 @@
+--TEST--
+Test user space classes that extend a native class
+--SKIPIF--
+<?php if (!extension_loaded("extension_for_tests")) print "skip"; ?>
+--FILEEOF--
+<?php
+
+/**
+ *  A user space class with its own doc comment
+ */
+class Level1 extends TestBaseClass\DataMembers {}
+
+/**
+ *  And a couple of levels deeper
+ */
+class Level2 extends Level1 {}
+class Level3 extends Level2 {}
+
+/**
+ *  The deepest class
+ */
+class Level4 extends Level3
+{
+    public function describe() { return get_class($this) . " " . $this->label; }
+}
+
+$object = new Level4();
+$object->label = "deep";
+$object->y = 7;
+echo $object->describe(), PHP_EOL;
+echo $object->dump(), PHP_EOL;
+
+$copy = clone $object;
+var_dump($copy->y, $object == $copy);
+--EXPECT--
+Level4 deep
+1.500000 7 200 true deep
+int(7)
+bool(true)
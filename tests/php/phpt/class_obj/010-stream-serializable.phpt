@@ -0,0 +1,42 @@
+--TEST--
+Test serializing with an encoder and a decoder
+--SKIPIF--
+<?php if (!extension_loaded("extension_for_tests")) print "skip"; ?>
+--FILEEOF--
+<?php
+
+$object = new TestBaseClass\StreamSerializable(-42, 0.25, "name", array(1, "two" => 2.5, "nested" => array(true, null, "x")));
+
+$copy = unserialize(serialize($object));
+echo $copy->describe(), PHP_EOL;
+var_dump($copy->extra());
+
+// data that is too short is reported with an exception
+$name = "TestBaseClass\\StreamSerializable";
+$data = 'C:' . strlen($name) . ':"' . $name . '":1:{x}';
+try
+{
+    unserialize($data);
+}
+catch (Exception $exception)
+{
+    echo "exception", PHP_EOL;
+}
+--EXPECT--
+-42 0.250000 name
+array(3) {
+  [0]=>
+  int(1)
+  ["two"]=>
+  float(2.5)
+  ["nested"]=>
+  array(3) {
+    [0]=>
+    bool(true)
+    [1]=>
+    NULL
+    [2]=>
+    string(1) "x"
+  }
+}
+exception
@@ -0,0 +1,47 @@
+--TEST--
+Test cloning native objects with declared and dynamic properties
+--SKIPIF--
+<?php if (!extension_loaded("extension_for_tests")) print "skip"; ?>
+--FILEEOF--
+<?php
+
+class Point extends TestBaseClass\DataMembers
+{
+    public $tag = "original";
+    
+    public function withLabel($label)
+    {
+        $copy = clone $this;
+        $copy->label = $label;
+        return $copy;
+    }
+}
+
+// declared properties are shared until one of the objects changes them
+$a = new Point();
+$b = $a->withLabel("copy");
+$b->tag = "copy";
+echo $a->label, " ", $a->tag, PHP_EOL;
+echo $b->label, " ", $b->tag, PHP_EOL;
+
+// dynamic properties are copied too
+$a->dynamic = array(1, 2);
+$c = clone $a;
+$c->dynamic[] = 3;
+echo count($a->dynamic), " ", count($c->dynamic), PHP_EOL;
+
+// a __clone() method in user space is still called
+class Counted extends Point
+{
+    public static $clones = 0;
+    public function __clone() { self::$clones++; }
+}
+$d = new Counted();
+$e = clone $d;
+$f = clone $e;
+echo Counted::$clones, PHP_EOL;
+--EXPECT--
+point original
+copy copy
+2 3
+2
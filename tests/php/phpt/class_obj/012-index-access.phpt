@@ -0,0 +1,40 @@
+--TEST--
+Test accessing an object with integer offsets
+--SKIPIF--
+<?php if (!extension_loaded("extension_for_tests")) print "skip"; ?>
+--FILEEOF--
+<?php
+
+$vector = new TestBaseClass\IndexVector();
+$vector[] = 1.5;
+$vector[] = 2;
+$vector[3] = "4.25";
+$vector["1"] = 7;
+
+echo count($vector), PHP_EOL;
+for ($i = 0; $i < count($vector); $i++) var_dump($vector[$i]);
+
+var_dump(isset($vector[2]), empty($vector[2]), isset($vector[10]));
+
+unset($vector[0]);
+echo count($vector), " ", $vector[0], PHP_EOL;
+
+try
+{
+    $vector[10];
+}
+catch (Exception $exception)
+{
+    echo $exception->getMessage(), PHP_EOL;
+}
+--EXPECT--
+4
+float(1.5)
+float(7)
+float(0)
+float(4.25)
+bool(true)
+bool(true)
+bool(false)
+3 7
+Index out of range
@@ -0,0 +1,25 @@
+--TEST--
+Test iterating over an object in blocks of elements
+--SKIPIF--
+<?php if (!extension_loaded("extension_for_tests")) print "skip"; ?>
+--FILEEOF--
+<?php
+
+$squares = new TestBaseClass\Squares(7);
+foreach ($squares as $key => $value) echo $key, ":", $value, " ";
+echo PHP_EOL;
+
+// the iterator can be used more than once
+foreach ($squares as $key => $value) echo $key, ":", $value, " ";
+echo PHP_EOL;
+
+foreach (new TestBaseClass\Squares(4, false) as $key => $value) echo $key, ":", $value, " ";
+echo PHP_EOL;
+
+foreach (new TestBaseClass\Squares(0) as $key => $value) echo $key, ":", $value, " ";
+echo "empty", PHP_EOL;
+--EXPECT--
+0:0 1:1 2:4 3:9 4:16 5:25 6:36 
+0:0 1:1 2:4 3:9 4:16 5:25 6:36 
+key0:0 key1:1 key2:4 key3:9 
+empty
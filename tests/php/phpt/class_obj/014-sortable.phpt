@@ -0,0 +1,39 @@
+--TEST--
+Test sorting objects by their native sort key
+--SKIPIF--
+<?php if (!extension_loaded("extension_for_tests")) print "skip"; ?>
+--FILEEOF--
+<?php
+
+$orders = array(
+    "a" => new TestBaseClass\Order("first", 12.5),
+    "b" => new TestBaseClass\Order("second", 3),
+    "c" => new TestBaseClass\Order("third", 12.5),
+    "d" => new TestBaseClass\Order("fourth", -1),
+);
+
+foreach (TestBaseClass\Order::sortAll($orders) as $key => $order) echo $key, ":", $order->name(), " ";
+echo PHP_EOL;
+
+foreach (TestBaseClass\Order::sortAll($orders, true) as $key => $order) echo $key, ":", $order->name(), " ";
+echo PHP_EOL;
+
+// the original array is not changed
+echo implode(" ", array_keys($orders)), PHP_EOL;
+
+// integers and floats are compared exactly, 2^53 + 1 is bigger than 2^53
+$exact = array(new TestBaseClass\Order("integer", 9007199254740993), new TestBaseClass\Order("float", 9007199254740992.0));
+foreach (TestBaseClass\Order::sortAll($exact) as $order) echo $order->name(), " ";
+echo PHP_EOL;
+
+// arrays with other elements can not be sorted
+var_dump(TestBaseClass\Order::sortAll(array(new TestBaseClass\Order("x", 1), new stdClass())));
+var_dump(TestBaseClass\Order::sortAll(array()));
+--EXPECT--
+0:fourth 1:second 2:first 3:third 
+0:first 1:third 2:second 3:fourth 
+a b c d
+float integer 
+bool(false)
+array(0) {
+}
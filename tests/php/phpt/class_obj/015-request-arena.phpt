@@ -0,0 +1,23 @@
+--TEST--
+Test allocating temporary data from the request arena
+--SKIPIF--
+<?php if (!extension_loaded("extension_for_tests")) print "skip"; ?>
+--FILEEOF--
+<?php
+
+$before = TestBaseClass\ArenaUser::statistics();
+echo TestBaseClass\ArenaUser::build(100000), PHP_EOL;
+$after = TestBaseClass\ArenaUser::statistics();
+
+var_dump($after["used"] > $before["used"]);
+var_dump($after["reserved"] >= $after["used"]);
+var_dump($after["peak"] >= $after["used"]);
+
+// sizes that overflow are refused
+var_dump(TestBaseClass\ArenaUser::overflow());
+--EXPECT--
+4999950000
+bool(true)
+bool(true)
+bool(true)
+bool(true)
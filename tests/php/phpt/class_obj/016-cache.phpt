@@ -0,0 +1,63 @@
+--TEST--
+Test storing values in a persistent cache
+--SKIPIF--
+<?php if (!extension_loaded("extension_for_tests")) print "skip"; ?>
+--FILEEOF--
+<?php
+
+var_dump(TestBaseClass\CacheUser::set("table", array("a" => 1, "b" => array(2.5, "three"))));
+var_dump(TestBaseClass\CacheUser::get("table"));
+var_dump(TestBaseClass\CacheUser::get("unknown"));
+var_dump(TestBaseClass\CacheUser::remove("table"));
+var_dump(TestBaseClass\CacheUser::get("table"));
+print_r(TestBaseClass\CacheUser::statistics());
+
+// values that are nested too deeply are rejected
+$recursive = array();
+$recursive[] = &$recursive;
+try { TestBaseClass\CacheUser::set("recursive", $recursive); } catch (Exception $e) { echo $e->getMessage(), PHP_EOL; }
+$deep = 1;
+for ($i = 0; $i < 600; $i++) $deep = array($deep);
+try { TestBaseClass\CacheUser::set("deep", $deep); } catch (Exception $e) { echo $e->getMessage(), PHP_EOL; }
+for ($i = 0; $i < 100; $i++) $deep = $deep[0];
+var_dump(TestBaseClass\CacheUser::set("deep", $deep));
+var_dump(TestBaseClass\CacheUser::get("deep") === $deep);
+
+// a value bigger than one shard (a quarter of the capacity) is not stored, and
+// it removes the old value with the same key
+var_dump(TestBaseClass\CacheUser::set("big", "small"));
+var_dump(TestBaseClass\CacheUser::set("big", str_repeat("x", 300000)));
+var_dump(TestBaseClass\CacheUser::get("big"));
+
+// PHP values and C++ objects are never mixed up
+var_dump(TestBaseClass\CacheUser::mixed());
+--EXPECT--
+bool(true)
+array(2) {
+  ["a"]=>
+  int(1)
+  ["b"]=>
+  array(2) {
+    [0]=>
+    float(2.5)
+    [1]=>
+    string(5) "three"
+  }
+}
+NULL
+bool(true)
+NULL
+Array
+(
+    [entries] => 0
+    [hits] => 1
+    [misses] => 2
+)
+Value is nested too deeply
+Value is nested too deeply
+bool(true)
+bool(true)
+bool(true)
+bool(false)
+NULL
+bool(true)
@@ -0,0 +1,48 @@
+--TEST--
+Test storing values in a shared memory cache
+--SKIPIF--
+<?php if (!extension_loaded("extension_for_tests")) print "skip"; ?>
+--FILEEOF--
+<?php
+
+var_dump(TestBaseClass\SharedCacheUser::set("config", array("name" => "test", "limits" => array(1, 2, 3))));
+var_dump(TestBaseClass\SharedCacheUser::set("counter", 42));
+var_dump(TestBaseClass\SharedCacheUser::set("counter", 43));
+var_dump(TestBaseClass\SharedCacheUser::get("config"));
+var_dump(TestBaseClass\SharedCacheUser::get("counter"));
+var_dump(TestBaseClass\SharedCacheUser::entries());
+var_dump(TestBaseClass\SharedCacheUser::remove("config"));
+var_dump(TestBaseClass\SharedCacheUser::get("config"));
+var_dump(TestBaseClass\SharedCacheUser::entries());
+
+// when the memory is full, older entries of the same size make room
+$stored = 0;
+for ($i = 0; $i < 20; $i++) $stored += TestBaseClass\SharedCacheUser::set("big$i", str_repeat("x", 300000));
+var_dump($stored);
+var_dump(strlen(TestBaseClass\SharedCacheUser::get("big19")));
+var_dump(TestBaseClass\SharedCacheUser::get("counter"));
+--EXPECT--
+bool(true)
+bool(true)
+bool(true)
+array(2) {
+  ["name"]=>
+  string(4) "test"
+  ["limits"]=>
+  array(3) {
+    [0]=>
+    int(1)
+    [1]=>
+    int(2)
+    [2]=>
+    int(3)
+  }
+}
+int(43)
+int(2)
+bool(true)
+NULL
+int(1)
+int(20)
+int(300000)
+int(43)
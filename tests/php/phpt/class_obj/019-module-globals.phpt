@@ -0,0 +1,26 @@
+--TEST--
+Test state that is stored in module globals
+--SKIPIF--
+<?php if (!extension_loaded("extension_for_tests")) print "skip"; ?>
+--FILEEOF--
+<?php
+
+print_r(TestBaseClass\Counter::increment());
+print_r(TestBaseClass\Counter::increment());
+print_r(TestBaseClass\Counter::increment());
+--EXPECT--
+Array
+(
+    [request] => 1
+    [thread] => 1
+)
+Array
+(
+    [request] => 2
+    [thread] => 2
+)
+Array
+(
+    [request] => 3
+    [thread] => 3
+)
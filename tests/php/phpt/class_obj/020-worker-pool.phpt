@@ -0,0 +1,18 @@
+--TEST--
+Test tasks that run in the background threads
+--SKIPIF--
+<?php if (!extension_loaded("extension_for_tests")) print "skip"; ?>
+--FILEEOF--
+<?php
+
+echo TestBaseClass\ParallelSum::squares(range(1, 1000)), PHP_EOL;
+echo TestBaseClass\ParallelSum::squares(array(3)), PHP_EOL;
+echo TestBaseClass\ParallelSum::squares(array()), PHP_EOL;
+echo TestBaseClass\ParallelSum::failure(), PHP_EOL;
+echo TestBaseClass\ParallelSum::nested(), PHP_EOL;
+--EXPECT--
+333833500
+9
+0
+task failed
+130816
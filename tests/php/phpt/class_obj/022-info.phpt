@@ -0,0 +1,29 @@
+--TEST--
+Test the section of the extension in the phpinfo() output
+--SKIPIF--
+<?php if (!extension_loaded("extension_for_tests")) print "skip"; ?>
+--FILEEOF--
+<?php
+
+TestBaseClass\Kernels\sum(array(1, 2));
+TestBaseClass\Kernels\sum(array(3, 4));
+$a = new TestBaseClass\Counter();
+$b = new TestBaseClass\Counter();
+
+ob_start();
+phpinfo(INFO_MODULES);
+$info = ob_get_clean();
+
+var_dump(strpos($info, "Version => 0.1") !== false);
+var_dump(strpos($info, "Instrumentation => enabled") !== false);
+var_dump(strpos($info, "Calls to TestBaseClass\\Kernels\\sum() => 2") !== false);
+var_dump(strpos($info, "Class TestBaseClass\\Counter => 2 objects") !== false);
+var_dump(strpos($info, "Test row => test value") !== false);
+var_dump(strpos($info, "extension_for_tests.number") !== false);
+--EXPECT--
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
@@ -0,0 +1,41 @@
+--TEST--
+Test a stream wrapper that keeps files in memory
+--SKIPIF--
+<?php if (!extension_loaded("extension_for_tests")) print "skip"; ?>
+--FILEEOF--
+<?php
+
+var_dump(file_exists("phpcpp://greeting"));
+var_dump(file_put_contents("phpcpp://greeting", "Hello from C++\n"));
+var_dump(file_exists("phpcpp://greeting"));
+var_dump(filesize("phpcpp://greeting"));
+echo file_get_contents("phpcpp://greeting");
+
+$fp = fopen("phpcpp://greeting", "r");
+fseek($fp, 6);
+echo fread($fp, 4), PHP_EOL;
+var_dump(ftell($fp));
+var_dump(stream_copy_to_stream($fp, fopen("php://output", "w")));
+fclose($fp);
+
+$fp = fopen("phpcpp://file" . __FILE__, "r");
+var_dump(stream_get_contents($fp) === file_get_contents(__FILE__));
+fclose($fp);
+
+var_dump(@fopen("phpcpp://missing", "r"));
+var_dump(unlink("phpcpp://greeting"));
+var_dump(file_exists("phpcpp://greeting"));
+--EXPECT--
+bool(false)
+int(15)
+bool(true)
+int(15)
+Hello from C++
+from
+int(10)
+ C++
+int(5)
+bool(true)
+bool(false)
+bool(true)
+bool(false)
@@ -0,0 +1,40 @@
+--TEST--
+Test reading PHP streams with a Php::InputStream
+--SKIPIF--
+<?php if (!extension_loaded("extension_for_tests")) print "skip"; ?>
+--FILEEOF--
+<?php
+
+$fp = fopen("php://memory", "w+");
+fwrite($fp, "first\nsecond\n\nlast");
+rewind($fp);
+var_dump(TestBaseClass\InputReader::lines($fp));
+fclose($fp);
+
+$fp = fopen("php://memory", "w+");
+fwrite($fp, str_repeat("x", 300000));
+rewind($fp);
+var_dump(TestBaseClass\InputReader::size($fp));
+fclose($fp);
+
+var_dump(TestBaseClass\InputReader::size(__FILE__) == filesize(__FILE__));
+
+$fp = fopen("php://memory", "w+");
+fwrite($fp, "1 2.5\n3\n");
+rewind($fp);
+var_dump(TestBaseClass\InputReader::sum($fp));
+fclose($fp);
+--EXPECT--
+array(4) {
+  [0]=>
+  string(5) "first"
+  [1]=>
+  string(6) "second"
+  [2]=>
+  string(0) ""
+  [3]=>
+  string(4) "last"
+}
+int(300000)
+bool(true)
+float(6.5)
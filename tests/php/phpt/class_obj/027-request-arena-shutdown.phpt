@@ -0,0 +1,20 @@
+--TEST--
+Test objects that keep request arena memory until the end of the script
+--SKIPIF--
+<?php if (!extension_loaded("extension_for_tests")) print "skip"; ?>
+--FILEEOF--
+<?php
+
+// objects in a global array and in a reference cycle are only destructed
+// when the engine cleans up, after the extensions have seen the request end
+$holders = array(new TestBaseClass\ArenaHolder(1000), array(new TestBaseClass\ArenaHolder(50000)));
+$cycle = new TestBaseClass\ArenaHolder(2000);
+$cycle->self = $cycle;
+
+echo $holders[0]->sum(), PHP_EOL;
+echo $holders[1][0]->sum(), PHP_EOL;
+echo $cycle->sum(), PHP_EOL;
+--EXPECT--
+499500
+1249975000
+1999000
@@ -0,0 +1,31 @@
+--TEST--
+Test sharing the entries of a shared memory cache with a forked process
+--SKIPIF--
+<?php if (!extension_loaded("extension_for_tests") || !function_exists("pcntl_fork")) print "skip"; ?>
+--FILEEOF--
+<?php
+
+var_dump(TestBaseClass\SharedCacheUser::set("parent", "from the parent"));
+
+$pid = pcntl_fork();
+if ($pid == 0)
+{
+    // the child sees the entry of the parent, and adds its own
+    var_dump(TestBaseClass\SharedCacheUser::get("parent"));
+    TestBaseClass\SharedCacheUser::set("child", array("from" => "the child"));
+    TestBaseClass\SharedCacheUser::remove("parent");
+    exit(0);
+}
+
+// the parent sees the changes of the child
+pcntl_waitpid($pid, $status);
+var_dump(TestBaseClass\SharedCacheUser::get("child"));
+var_dump(TestBaseClass\SharedCacheUser::get("parent"));
+--EXPECT--
+bool(true)
+string(15) "from the parent"
+array(1) {
+  ["from"]=>
+  string(9) "the child"
+}
+NULL
@@ -0,0 +1,25 @@
+--TEST--
+Test tasks that run in the background threads of a forked process
+--SKIPIF--
+<?php if (!extension_loaded("extension_for_tests") || !function_exists("pcntl_fork")) print "skip"; ?>
+--FILEEOF--
+<?php
+
+// the threads are started in the parent
+echo TestBaseClass\ParallelSum::squares(range(1, 1000)), PHP_EOL;
+
+$pid = pcntl_fork();
+if ($pid == 0)
+{
+    // the child starts its own threads
+    echo "child ", TestBaseClass\ParallelSum::squares(range(1, 10)), PHP_EOL;
+    exit(0);
+}
+
+// the threads of the parent still work
+pcntl_waitpid($pid, $status);
+echo "parent ", TestBaseClass\ParallelSum::squares(range(1, 10)), PHP_EOL;
+--EXPECT--
+333833500
+child 385
+parent 385
@@ -0,0 +1,54 @@
+--TEST--
+Test php.ini settings that are bound to variables
+--SKIPIF--
+<?php if (!extension_loaded("extension_for_tests")) print "skip"; ?>
+--INI--
+extension_for_tests.ratio=0.5
+extension_for_tests.size=2K
+--FILEEOF--
+<?php
+
+print_r(TestExtension\IniSettings::values());
+
+var_dump(ini_set("extension_for_tests.number", "42"));
+var_dump(ini_set("extension_for_tests.enabled", "off"));
+var_dump(ini_set("extension_for_tests.size", "16M"));
+var_dump(ini_set("extension_for_tests.size", "lots"));
+var_dump(ini_set("extension_for_tests.size", "99999999999G"));
+var_dump(ini_set("extension_for_tests.number", "99999999999999999999"));
+var_dump(ini_set("extension_for_tests.name", "changed"));
+var_dump(ini_set("extension_for_tests.limit", "7"));
+var_dump(ini_get("extension_for_tests.number"));
+print_r(TestExtension\IniSettings::values());
+
+ini_restore("extension_for_tests.number");
+echo TestExtension\IniSettings::values()["number"], PHP_EOL;
+--EXPECT--
+Array
+(
+    [number] => 10
+    [ratio] => 0.5
+    [enabled] => 1
+    [name] => default
+    [size] => 2048
+    [limit] => 5
+)
+string(2) "10"
+string(1) "1"
+string(2) "2K"
+bool(false)
+bool(false)
+bool(false)
+string(7) "default"
+string(1) "5"
+string(2) "42"
+Array
+(
+    [number] => 42
+    [ratio] => 0.5
+    [enabled] => 
+    [name] => changed
+    [size] => 16777216
+    [limit] => 7
+)
+10
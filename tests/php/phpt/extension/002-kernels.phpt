@@ -0,0 +1,69 @@
+--TEST--
+Test the numeric kernels
+--SKIPIF--
+<?php if (!extension_loaded("extension_for_tests")) print "skip"; ?>
+--FILEEOF--
+<?php
+
+$numbers = array(3, "1", 4.5, 1, 5, 9, 2, 6);
+var_dump(TestExtension\Kernels\sum($numbers));
+var_dump(TestExtension\Kernels\mean($numbers));
+var_dump(TestExtension\Kernels\mean(array()));
+var_dump(TestExtension\Kernels\min($numbers));
+var_dump(TestExtension\Kernels\max($numbers));
+var_dump(TestExtension\Kernels\dot(array(1, 2, 3), array(4, 5, 6)));
+echo implode(",", TestExtension\Kernels\prefixSum(array(1, 2, 3, 4))), PHP_EOL;
+echo implode(",", TestExtension\Kernels\histogram($numbers, 4)), PHP_EOL;
+echo implode(",", TestExtension\Kernels\histogram($numbers, 2, 0, 4)), PHP_EOL;
+echo implode(",", TestExtension\Kernels\sort($numbers)), PHP_EOL;
+
+// big arrays are processed in parallel
+$big = range(1, 200000);
+var_dump(TestExtension\Kernels\sum($big) == array_sum($big));
+$prefix = TestExtension\Kernels\prefixSum($big);
+var_dump($prefix[199999] == array_sum($big));
+$sorted = TestExtension\Kernels\sort(array_reverse($big));
+var_dump($sorted[0] == 1 && $sorted[199999] == 200000);
+var_dump(array_sum(TestExtension\Kernels\histogram($big, 7)));
+var_dump(array_sum(TestExtension\Kernels\histogram($big, 500000)));
+
+// NaN is ignored by min, max and histogram, and sorted to the end
+$nan = array(NAN, 3, -1, NAN, 7);
+var_dump(TestExtension\Kernels\min($nan));
+var_dump(TestExtension\Kernels\max($nan));
+var_dump(TestExtension\Kernels\max(array(NAN, NAN)));
+echo implode(",", TestExtension\Kernels\histogram($nan, 2)), PHP_EOL;
+echo implode(",", TestExtension\Kernels\sort($nan)), PHP_EOL;
+
+// the number of bins is limited
+try { TestExtension\Kernels\histogram($numbers, 1e9); } catch (Exception $e) { echo $e->getMessage(), PHP_EOL; }
+
+// the range of a histogram must be finite
+try { TestExtension\Kernels\histogram(array(1, INF), 2); } catch (Exception $e) { echo $e->getMessage(), PHP_EOL; }
+try { TestExtension\Kernels\histogram($numbers, 2, -1.5e308, 1.5e308); } catch (Exception $e) { echo $e->getMessage(), PHP_EOL; }
+echo implode(",", TestExtension\Kernels\histogram(array(1e300, 2e300, 3e300), 3, 0, 3e300)), PHP_EOL;
+--EXPECT--
+float(31.5)
+float(3.9375)
+NULL
+float(1)
+float(9)
+float(32)
+1,3,6,10
+3,2,2,1
+2,2
+1,1,2,3,4.5,5,6,9
+bool(true)
+bool(true)
+bool(true)
+int(200000)
+int(200000)
+float(-1)
+float(7)
+float(NAN)
+1,2
+-1,3,7,NAN,NAN
+Number of bins is too big
+Range of the histogram must be finite
+Range of the histogram is too big
+0,1,2
@@ -0,0 +1,28 @@
+--TEST--
+Test output that is written to Php::out
+--SKIPIF--
+<?php if (!extension_loaded("extension_for_tests")) print "skip"; ?>
+--FILEEOF--
+<?php
+
+echo "start:";
+TestExtension\Output::pieces(5);
+echo ":middle:";
+
+ob_start();
+TestExtension\Output::block(200000, "end");
+$output = ob_get_clean();
+echo strlen($output), ":", substr($output, -4), ":";
+
+ob_start();
+TestExtension\Output::pieces(20000);
+$output = ob_get_clean();
+echo strlen($output), ":done", PHP_EOL;
+
+// the field width also applies to strings
+echo "[";
+TestExtension\Output::padded("abc", 6);
+echo "]", PHP_EOL;
+--EXPECT--
+start:0,1,2,3,4,:middle:200003:xend:108890:done
+[   abc]
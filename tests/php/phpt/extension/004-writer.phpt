@@ -0,0 +1,22 @@
+--TEST--
+Test output that is written with a Php::Writer
+--SKIPIF--
+<?php if (!extension_loaded("extension_for_tests")) print "skip"; ?>
+--FILEEOF--
+<?php
+
+TestExtension\Templates::rows(array("plain", "<b>bold</b>", "Tom & 'Jerry'"));
+TestExtension\Templates::json("say \"hi\"\n", 0.1);
+TestExtension\Templates::json("number", -1234567);
+TestExtension\Templates::json("tab\there", 1.0E+25);
+TestExtension\Templates::json("huge", -1.0E+20);
+echo "done", PHP_EOL;
+--EXPECT--
+<tr><td>0</td><td>plain</td></tr>
+<tr><td>1</td><td>&lt;b&gt;bold&lt;/b&gt;</td></tr>
+<tr><td>2</td><td>Tom &amp; &#039;Jerry&#039;</td></tr>
+{"name":"say \"hi\"\n","value":0.1}
+{"name":"number","value":-1234567}
+{"name":"tab\there","value":1e+25}
+{"name":"huge","value":-1e+20}
+done
@@ -0,0 +1,18 @@
+--TEST--
+Test floating point numbers that are written with a Php::Writer in a locale with a decimal comma
+--SKIPIF--
+<?php
+if (!extension_loaded("extension_for_tests")) print "skip";
+elseif (!setlocale(LC_NUMERIC, "de_DE.UTF-8", "de_DE", "nl_NL.UTF-8", "nl_NL")) print "skip no locale with a decimal comma";
+?>
+--FILEEOF--
+<?php
+
+setlocale(LC_NUMERIC, "de_DE.UTF-8", "de_DE", "nl_NL.UTF-8", "nl_NL");
+TestExtension\Templates::json("fraction", 3.25);
+TestExtension\Templates::json("third", 1/3);
+TestExtension\Templates::json("exponent", 1.5E-7);
+--EXPECT--
+{"name":"fraction","value":3.25}
+{"name":"third","value":0.3333333333333333}
+{"name":"exponent","value":1.5e-07}
@@ -0,0 +1,14 @@
+--TEST--
+Test looking up array elements with Php::Value
+--DESCRIPTION--
+--SKIPIF--
+<?php if (!extension_loaded("extension_for_tests")) print "skip"; ?>
+--FILEEOF--
+<?php
+
+// the elements that are not integers are not counted
+var_dump(TestVariables\value_lookups(array(1, 2, "three", 4), 3));
+var_dump(TestVariables\value_lookups(array(), 10));
+--EXPECT--
+int(9)
+int(0)
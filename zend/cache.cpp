@@ -0,0 +1,409 @@
+/**
+ *  Cache.cpp
+ *
+ *  Implementation of the Cache and CacheImpl classes
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 Copernica BV
+ */
+#include "includes.h"
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Estimated number of bytes that an entry uses on top of its key and object
+ *  @var    size_t
+ */
+static const size_t overhead = 128;
+
+/**
+ *  Constructor
+ *  @param  capacity    Max number of bytes to store
+ *  @param  shards      Number of shards
+ */
+CacheImpl::CacheImpl(size_t capacity, size_t shards) : _shards(shards > 0 ? shards : 1)
+{
+    // divide the capacity over the shards
+    for (auto &shard : _shards) shard.statistics.capacity = shard.capacity = capacity / _shards.size();
+}
+
+/**
+ *  Remove an entry from a shard (the shard must be locked)
+ *  @param  shard
+ *  @param  iter
+ *  @param  garbage
+ */
+void CacheImpl::erase(Shard &shard, std::list<Entry>::iterator iter, std::list<Entry> &garbage)
+{
+    // update the counters
+    shard.statistics.bytes -= iter->size;
+    shard.statistics.entries -= 1;
+
+    // remove from the index, and move the entry to the garbage
+    shard.index.erase(iter->key);
+    garbage.splice(garbage.end(), shard.entries, iter);
+}
+
+/**
+ *  Find an entry that has not yet expired (the shard must be locked)
+ *  @param  shard
+ *  @param  key
+ *  @param  garbage     Where an expired entry is moved to
+ *  @return Entry       Pointer to the entry or nullptr
+ */
+CacheImpl::Entry *CacheImpl::find(Shard &shard, const std::string &key, std::list<Entry> &garbage)
+{
+    // look up the entry
+    auto iter = shard.index.find(key);
+    if (iter == shard.index.end()) return nullptr;
+
+    // the entry in the list
+    auto entry = iter->second;
+
+    // has the entry expired?
+    if (entry->expiring && entry->expires <= Clock::now())
+    {
+        // remove the entry
+        shard.statistics.expirations += 1;
+        erase(shard, entry, garbage);
+
+        // not found
+        return nullptr;
+    }
+
+    // move the entry to the front, because it is the most recently used
+    shard.entries.splice(shard.entries.begin(), shard.entries, entry);
+
+    // done
+    return &*entry;
+}
+
+/**
+ *  Store an object
+ *  @param  key         The key
+ *  @param  object      The object
+ *  @param  type        Type of the object
+ *  @param  size        Size of the object
+ *  @param  ttl         Time to live in seconds
+ *  @return bool
+ */
+bool CacheImpl::store(const std::string &key, std::shared_ptr<const void> &&object, const std::type_info &type, size_t size, int ttl)
+{
+    // the key is stored twice (in the entry and in the index)
+    size += 2 * key.size() + overhead;
+
+    // find the shard
+    Shard &shard = this->shard(key);
+
+    // objects that were replaced or evicted are destructed after the lock is 
+    // released, because the destructors could take some time
+    std::list<Entry> garbage;
+
+    // lock the shard
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    // remove the old entry with the same key (also when the new entry is not
+    // stored, because the old value should then no longer be returned)
+    auto iter = shard.index.find(key);
+    if (iter != shard.index.end()) 
+    {
+        // update the counters
+        shard.statistics.bytes -= iter->second->size;
+        shard.statistics.entries -= 1;
+        
+        // move the entry to the garbage
+        garbage.splice(garbage.end(), shard.entries, iter->second);
+        shard.index.erase(iter);
+    }
+
+    // entries that do not fit in the shard at all are not stored (the capacity
+    // is divided over the shards, so this limit is lower than the capacity)
+    if (size > shard.capacity) return false;
+
+    // remove the least recently used entries until there is enough room
+    while (shard.statistics.bytes + size > shard.capacity)
+    {
+        // the least recently used entry
+        auto last = std::prev(shard.entries.end());
+
+        // update the counters, an entry that has already expired is not really evicted
+        if (last->expiring && last->expires <= Clock::now()) shard.statistics.expirations += 1;
+        else shard.statistics.evictions += 1;
+        shard.statistics.bytes -= last->size;
+        shard.statistics.entries -= 1;
+
+        // move the entry to the garbage
+        shard.index.erase(last->key);
+        garbage.splice(garbage.end(), shard.entries, last);
+    }
+
+    // add the entry at the front
+    shard.entries.push_front(Entry{ key, std::move(object), &type, size, Clock::now() + std::chrono::seconds(ttl), ttl > 0 });
+    shard.index[key] = shard.entries.begin();
+
+    // update the counters
+    shard.statistics.bytes += size;
+    shard.statistics.entries += 1;
+    shard.statistics.insertions += 1;
+
+    // done
+    return true;
+}
+
+/**
+ *  Retrieve an object
+ *  @param  key         The key
+ *  @param  type        Expected type of the object
+ *  @return std::shared_ptr
+ */
+std::shared_ptr<const void> CacheImpl::fetch(const std::string &key, const std::type_info &type)
+{
+    // find the shard
+    Shard &shard = this->shard(key);
+
+    // an expired entry is destructed after the lock is released
+    std::list<Entry> garbage;
+
+    // lock the shard
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    // find the entry
+    Entry *entry = find(shard, key, garbage);
+
+    // an entry of a different type does not count as a hit
+    if (!entry || *entry->type != type)
+    {
+        // not found
+        shard.statistics.misses += 1;
+        return nullptr;
+    }
+
+    // found
+    shard.statistics.hits += 1;
+    return entry->object;
+}
+
+/**
+ *  Check if an entry exists
+ *  @param  key
+ *  @return bool
+ */
+bool CacheImpl::exists(const std::string &key)
+{
+    // find the shard
+    Shard &shard = this->shard(key);
+
+    // an expired entry is destructed after the lock is released
+    std::list<Entry> garbage;
+
+    // lock the shard
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    // look up the entry
+    return find(shard, key, garbage) != nullptr;
+}
+
+/**
+ *  Remove an entry
+ *  @param  key
+ *  @return bool
+ */
+bool CacheImpl::remove(const std::string &key)
+{
+    // find the shard
+    Shard &shard = this->shard(key);
+
+    // the removed entry is destructed after the lock is released
+    std::list<Entry> garbage;
+
+    // lock the shard
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    // look up the entry
+    auto iter = shard.index.find(key);
+    if (iter == shard.index.end()) return false;
+
+    // remove it
+    erase(shard, iter->second, garbage);
+
+    // done
+    return true;
+}
+
+/**
+ *  Remove all entries
+ */
+void CacheImpl::clear()
+{
+    // loop through the shards
+    for (auto &shard : _shards)
+    {
+        // the entries are destructed after the lock is released
+        std::list<Entry> garbage;
+
+        // lock the shard
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        // forget all entries
+        shard.index.clear();
+        garbage.swap(shard.entries);
+
+        // update the counters
+        shard.statistics.bytes = 0;
+        shard.statistics.entries = 0;
+    }
+}
+
+/**
+ *  Retrieve the counters of all shards together
+ *  @return CacheStatistics
+ */
+CacheStatistics CacheImpl::statistics()
+{
+    // the result
+    CacheStatistics result;
+
+    // loop through the shards
+    for (auto &shard : _shards)
+    {
+        // lock the shard
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        // add the counters
+        result.capacity += shard.statistics.capacity;
+        result.bytes += shard.statistics.bytes;
+        result.entries += shard.statistics.entries;
+        result.hits += shard.statistics.hits;
+        result.misses += shard.statistics.misses;
+        result.insertions += shard.statistics.insertions;
+        result.evictions += shard.statistics.evictions;
+        result.expirations += shard.statistics.expirations;
+    }
+
+    // done
+    return result;
+}
+
+/**
+ *  Constructor
+ *  @param  capacity    Max number of bytes to store
+ *  @param  shards      Number of independently locked parts
+ */
+Cache::Cache(size_t capacity, size_t shards) : _impl(new CacheImpl(capacity, shards)) {}
+
+/**
+ *  Destructor
+ */
+Cache::~Cache()
+{
+    // destruct the implementation
+    delete _impl;
+}
+
+/**
+ *  Store a PHP value
+ *  @param  key         The key
+ *  @param  value       Value to store
+ *  @param  ttl         Time to live in seconds, zero for no expiration
+ *  @return bool        False if the value does not fit in the cache
+ */
+bool Cache::set(const std::string &key, const Value &value, int ttl)
+{
+    // encode the value, the encoder uses request memory, so we make a
+    // persistent copy of the encoded data
+    Encoder encoder;
+    encoder.writeValue(value);
+    auto data = std::make_shared<const std::string>(encoder.data(), encoder.size());
+    size_t size = data->size();
+
+    // store the data
+    return _impl->store(key, std::move(data), typeid(EncodedValue), size, ttl);
+}
+
+/**
+ *  Retrieve a PHP value
+ *  @param  key         The key
+ *  @return Value       The value, or NULL if it was not found
+ */
+Value Cache::get(const std::string &key)
+{
+    // fetch the encoded value
+    auto data = std::static_pointer_cast<const std::string>(_impl->fetch(key, typeid(EncodedValue)));
+    if (!data) return nullptr;
+
+    // decode the value (the lock is no longer held, and the entry remains 
+    // valid because we hold a reference to it)
+    Decoder decoder(data->data(), data->size());
+    return decoder.readValue();
+}
+
+/**
+ *  Store a C++ object
+ *  @param  key         The key
+ *  @param  object      The object
+ *  @param  type        Type of the object
+ *  @param  size        Size of the object
+ *  @param  ttl         Time to live in seconds
+ *  @return bool
+ */
+bool Cache::store(const std::string &key, std::shared_ptr<const void> &&object, const std::type_info &type, size_t size, int ttl)
+{
+    return _impl->store(key, std::move(object), type, size, ttl);
+}
+
+/**
+ *  Retrieve a C++ object
+ *  @param  key         The key
+ *  @param  type        Expected type of the object
+ *  @return std::shared_ptr
+ */
+std::shared_ptr<const void> Cache::fetch(const std::string &key, const std::type_info &type)
+{
+    return _impl->fetch(key, type);
+}
+
+/**
+ *  Check if an entry exists
+ *  @param  key         The key
+ *  @return bool
+ */
+bool Cache::exists(const std::string &key)
+{
+    return _impl->exists(key);
+}
+
+/**
+ *  Remove an entry
+ *  @param  key         The key
+ *  @return bool        Was the entry found?
+ */
+bool Cache::remove(const std::string &key)
+{
+    return _impl->remove(key);
+}
+
+/**
+ *  Remove all entries
+ */
+void Cache::clear()
+{
+    _impl->clear();
+}
+
+/**
+ *  Retrieve the counters of the cache
+ *  @return CacheStatistics
+ */
+CacheStatistics Cache::statistics() const
+{
+    return _impl->statistics();
+}
+
+/**
+ *  End namespace
+ */
+}
+
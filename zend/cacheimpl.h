@@ -0,0 +1,211 @@
+/**
+ *  CacheImpl.h
+ *
+ *  Implementation of the cache. The entries are spread over a number of
+ *  shards, each shard has its own lock and its own list of entries, ordered
+ *  from most recently used to least recently used.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Type with which encoded PHP values are tagged, this is a private type, so 
+ *  that the encoded values can not be mixed up with C++ objects (not even 
+ *  with a C++ object of type Php::Value or std::string)
+ */
+struct EncodedValue {};
+
+/**
+ *  Class definition
+ */
+class CacheImpl
+{
+public:
+    /**
+     *  The clock that is used for the time to live
+     */
+    typedef std::chrono::steady_clock Clock;
+
+    /**
+     *  A single entry
+     */
+    struct Entry
+    {
+        /**
+         *  The key
+         *  @var    std::string
+         */
+        std::string key;
+
+        /**
+         *  The stored object (for PHP values this is a std::string holding 
+         *  the encoded value, and the type is EncodedValue)
+         *  @var    std::shared_ptr
+         */
+        std::shared_ptr<const void> object;
+
+        /**
+         *  Type of the object
+         *  @var    std::type_info
+         */
+        const std::type_info *type;
+
+        /**
+         *  Number of bytes that are used by the entry
+         *  @var    size_t
+         */
+        size_t size;
+
+        /**
+         *  Moment when the entry expires
+         *  @var    Clock::time_point
+         */
+        Clock::time_point expires;
+
+        /**
+         *  Does the entry expire?
+         *  @var    bool
+         */
+        bool expiring;
+    };
+
+    /**
+     *  A shard
+     */
+    struct Shard
+    {
+        /**
+         *  Lock that protects the shard
+         *  @var    std::mutex
+         */
+        std::mutex mutex;
+
+        /**
+         *  The entries, the most recently used entry is at the front
+         *  @var    std::list
+         */
+        std::list<Entry> entries;
+
+        /**
+         *  Index to find the entries by their key
+         *  @var    std::unordered_map
+         */
+        std::unordered_map<std::string, std::list<Entry>::iterator> index;
+
+        /**
+         *  Max number of bytes in this shard
+         *  @var    size_t
+         */
+        size_t capacity = 0;
+
+        /**
+         *  The counters of this shard
+         *  @var    CacheStatistics
+         */
+        CacheStatistics statistics;
+    };
+
+private:
+    /**
+     *  The shards
+     *  @var    std::vector
+     */
+    std::vector<Shard> _shards;
+
+    /**
+     *  Find the shard for a key
+     *  @param  key
+     *  @return Shard
+     */
+    Shard &shard(const std::string &key)
+    {
+        return _shards[std::hash<std::string>()(key) % _shards.size()];
+    }
+
+    /**
+     *  Remove an entry from a shard (the shard must be locked), the entry is 
+     *  moved to the garbage, so that the caller can destruct the object after 
+     *  the lock is released
+     *  @param  shard
+     *  @param  iter
+     *  @param  garbage
+     */
+    static void erase(Shard &shard, std::list<Entry>::iterator iter, std::list<Entry> &garbage);
+
+    /**
+     *  Find an entry that has not yet expired (the shard must be locked)
+     *  @param  shard
+     *  @param  key
+     *  @param  garbage     Where an expired entry is moved to
+     *  @return Entry       Pointer to the entry or nullptr
+     */
+    static Entry *find(Shard &shard, const std::string &key, std::list<Entry> &garbage);
+
+public:
+    /**
+     *  Constructor
+     *  @param  capacity    Max number of bytes to store
+     *  @param  shards      Number of shards
+     */
+    CacheImpl(size_t capacity, size_t shards);
+
+    /**
+     *  Destructor
+     */
+    virtual ~CacheImpl() {}
+
+    /**
+     *  Store an object
+     *  @param  key         The key
+     *  @param  object      The object
+     *  @param  type        Type of the object
+     *  @param  size        Size of the object
+     *  @param  ttl         Time to live in seconds
+     *  @return bool
+     */
+    bool store(const std::string &key, std::shared_ptr<const void> &&object, const std::type_info &type, size_t size, int ttl);
+
+    /**
+     *  Retrieve an object
+     *  @param  key         The key
+     *  @param  type        Expected type of the object
+     *  @return std::shared_ptr
+     */
+    std::shared_ptr<const void> fetch(const std::string &key, const std::type_info &type);
+
+    /**
+     *  Check if an entry exists
+     *  @param  key
+     *  @return bool
+     */
+    bool exists(const std::string &key);
+
+    /**
+     *  Remove an entry
+     *  @param  key
+     *  @return bool
+     */
+    bool remove(const std::string &key);
+
+    /**
+     *  Remove all entries
+     */
+    void clear();
+
+    /**
+     *  Retrieve the counters of all shards together
+     *  @return CacheStatistics
+     */
+    CacheStatistics statistics();
+};
+
+/**
+ *  End namespace
+ */
+}
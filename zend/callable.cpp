@@ -25,12 +25,18 @@ namespace Php {
  */
 void Callable::invoke(INTERNAL_FUNCTION_PARAMETERS)
 {
+    // remember the tsrm_ls pointer, so that it does not have to be fetched
+    TSRMLS_CACHED_STORE();
+    
     // find the function name
     const char *name = get_active_function_name(TSRMLS_C);
     
     // uncover the hidden pointer inside the function name
     Callable *callable = HiddenPointer<Callable>(name);
 
+    // count the call
+    if (callable->_instrumented) callable->_calls.fetch_add(1, std::memory_order_relaxed);
+
     // construct parameters
     ParametersImpl params(this_ptr, ZEND_NUM_ARGS() TSRMLS_CC);
 
@@ -53,6 +59,10 @@ void Callable::invoke(INTERNAL_FUNCTION_PARAMETERS)
         // process the exception
         process(exception TSRMLS_CC);
     }
+    
+    // output that is still in the buffer of Php::out must be sent before 
+    // the script continues, otherwise it would end up after output of the script
+    out.rdbuf()->pubsync();
 }
 
 /**
@@ -103,6 +103,32 @@ public:
      */
     void initialize(zend_arg_info *info, const char *classname = nullptr) const;
 
+    /**
+     *  Name of the function or method
+     *  @return const char *
+     */
+    const char *name() const
+    {
+        return _ptr;
+    }
+
+    /**
+     *  Start counting the calls
+     */
+    void instrument()
+    {
+        _instrumented = true;
+    }
+
+    /**
+     *  Number of calls since the instrumentation was enabled
+     *  @return uint64_t
+     */
+    uint64_t calls() const
+    {
+        return _calls;
+    }
+
 
 protected:
     /**
@@ -135,6 +161,18 @@ protected:
      */
     zend_arg_info *_argv = nullptr;
     
+    /**
+     *  Are the calls counted?
+     *  @var    bool
+     */
+    bool _instrumented = false;
+    
+    /**
+     *  Number of calls
+     *  @var    std::atomic
+     */
+    std::atomic<uint64_t> _calls{0};
+    
     /**
      *  Private helper method to fill an argument object
      *  @param  info        object from the zend engine
@@ -83,6 +83,13 @@ void ClassBase::method(const char *name, const native_callback_3 &method, int fl
  */
 void ClassBase::method(const char *name, int flags, const Arguments &args) { _impl->method(name, flags, args); }
 
+/**
+ *  Add a method that is implemented by the __call() or __callStatic() method
+ *  @param  name        Name of the method
+ *  @param  flags       Optional flags (Php::Static for __callStatic())
+ */
+void ClassBase::dynamicMethod(const char *name, int flags) { _impl->dynamicMethod(name, flags); }
+
 /**
  *  Add a property to the class
  *  @param  name        Name of the property
@@ -111,6 +118,13 @@ void ClassBase::property(const char *name, const getter_callback_1 &getter, cons
 void ClassBase::property(const char *name, const getter_callback_0 &getter, const setter_callback_1 &setter) { _impl->property(name, getter, setter); }
 void ClassBase::property(const char *name, const getter_callback_1 &getter, const setter_callback_1 &setter) { _impl->property(name, getter, setter); }
 
+/**
+ *  Set property that is bound to a data member
+ *  @param  name        Name of the property
+ *  @param  member      The data member
+ */
+void ClassBase::property(const char *name, const std::shared_ptr<DataMember> &member) { _impl->property(name, member); }
+
 /**
  *  Add an interface
  *  @param  interface       Interface object
@@ -123,6 +137,18 @@ void ClassBase::implements(const ClassBase &interface) { _impl->implements(inter
  */
 void ClassBase::extends(const ClassBase &base) { _impl->extends(base._impl); }
 
+/**
+ *  Enable the object pool
+ *  @param  capacity        Max number of idle objects to keep
+ */
+void ClassBase::pool(size_t capacity) { _impl->pool(capacity); }
+
+/**
+ *  Retrieve the counters of the object pool
+ *  @return PoolStatistics
+ */
+PoolStatistics ClassBase::statistics() const { return _impl->statistics(); }
+
 /**
  *  End namespace
  */
@@ -13,6 +13,48 @@
  */
 namespace Php {
 
+/**
+ *  Extended zend_internal_function structure that we use to store an
+ *  instance of the ClassBase object. We need this for static method calls
+ */
+struct CallData
+{
+    // the internal function is the first member, so
+    // that it is possible to cast an instance of this 
+    // struct to a zend_internal_function
+    zend_internal_function func;
+    
+    // and a pointer to the ClassImpl object
+    ClassImpl *self;
+};
+
+/**
+ *  Function that is called by the Zend engine to destruct the persistent
+ *  function records in the hash tables
+ *  @param  data        Pointer to the stored CallData pointer
+ */
+static void destroyCallData(void *data)
+{
+    // deallocate the record (the method name was allocated in the same block)
+    pefree(*(CallData **)data, 1);
+}
+
+/**
+ *  Constructor
+ *  @param  name            Class name
+ *  @param  type            Class type
+ */
+ClassImpl::ClassImpl(const char *name, ClassType type) : _name(name), _type(type)
+{
+    // initialize the persistent tables with function records for magic methods
+    zend_hash_init(&_forwarders, 0, nullptr, destroyCallData, 1);
+    zend_hash_init(&_staticForwarders, 0, nullptr, destroyCallData, 1);
+    
+    // initialize the index of properties with callbacks (the properties themselves
+    // are owned by the _properties map, so no destructor is necessary)
+    zend_hash_init(&_accessors, 0, nullptr, nullptr, 1);
+}
+
 /**
  *  Destructor
  */
@@ -21,10 +63,13 @@ ClassImpl::~ClassImpl()
     // destruct the entries
     if (_entries) delete[] _entries;
 
-    // php 5.3 deallocates the doc_comment by iself
-#if PHP_VERSION_ID >= 50400    
-    if (_comment) free(_comment);
-#endif
+    // destruct the function records for magic methods
+    zend_hash_destroy(&_forwarders);
+    zend_hash_destroy(&_staticForwarders);
+    if (_invoker) pefree(_invoker, 1);
+    
+    // destruct the property index
+    zend_hash_destroy(&_accessors);
 }
 
 /**
@@ -32,43 +77,71 @@ ClassImpl::~ClassImpl()
  */
 
 /**
- *  Retrieve our C++ implementation object
- *  @param  entry
- *  @return ClassImpl
+ *  All classes that are registered by the extension, indexed by their class entry
+ * 
+ *  The map is filled on module startup, and only read afterwards, so it can be
+ *  safely accessed from multiple threads. Entries are never removed: the class 
+ *  entries are destructed by the engine when the module is unloaded anyway
+ * 
+ *  @return std::unordered_map
  */
-static ClassImpl *self(zend_class_entry *entry)
+static std::unordered_map<const zend_class_entry*,ClassImpl*> &registry()
 {
-    // we need the base class (in user space the class may have been overridden,
-    // but we are not interested in these user space classes)
-    while (entry->parent) entry = entry->parent;
+    // the one and only instance
+    static std::unordered_map<const zend_class_entry*,ClassImpl*> classes;
     
-#if PHP_VERSION_ID >= 50400
-    // retrieve the comment (it has a pointer hidden in it to the ClassBase object)
-    const char *comment = entry->info.user.doc_comment;
-#else
-    // retrieve the comment php5.3 style (it has a pointer hidden in it to the ClassBase object)
-    const char *comment = entry->doc_comment;
-#endif    
+    // expose it
+    return classes;
+}
+
+/**
+ *  Find the implementation object that belongs to a class entry
+ *  @param  entry       The class entry
+ *  @return ClassImpl   The implementation, or nullptr if the class is not ours
+ */
+ClassImpl *ClassImpl::find(const zend_class_entry *entry)
+{
+    // the registered classes
+    auto &classes = registry();
+    
+    // user space classes may extend our classes, so we go up until we find one
+    for (; entry; entry = entry->parent)
+    {
+        // is this one of our classes?
+        auto iter = classes.find(entry);
+        if (iter != classes.end()) return iter->second;
+    }
     
-    // the first byte of the comment is an empty string (null character), but
-    // the next bytes contain a pointer to the ClassBase class
-    return *((ClassImpl **)(comment + 1));
+    // not one of our classes
+    return nullptr;
 }
 
 /**
- *  Extended zend_internal_function structure that we use to store an
- *  instance of the ClassBase object. We need this for static method calls
+ *  Fill a function record that forwards a call to a magic method
+ *  @param  data        The record to fill
+ *  @param  handler     The handler function that is called
+ *  @param  scope       Scope of the function
+ *  @param  name        Name of the function
+ *  @param  flags       Function flags
+ *  @param  impl        Our meta information object
  */
-struct CallData
+static void fill(CallData *data, void (*handler)(INTERNAL_FUNCTION_PARAMETERS), zend_class_entry *scope, const char *name, zend_uint flags, ClassImpl *impl)
 {
-    // the internal function is the first member, so
-    // that it is possible to cast an instance of this 
-    // struct to a zend_internal_function
-    zend_internal_function func;
+    // we're going to set all properties
+    auto *function = &data->func;
+    function->type = ZEND_INTERNAL_FUNCTION;
+    function->module = nullptr;
+    function->handler = handler;
+    function->arg_info = nullptr;
+    function->num_args = 0;
+    function->required_num_args = 0;
+    function->scope = scope;
+    function->fn_flags = flags;
+    function->function_name = (char *)name;
     
-    // and a pointer to the ClassImpl object
-    ClassImpl *self;
-};
+    // store pointer to ourselves
+    data->self = impl;
+}
 
 /**
  *  Handler function that runs the __call function
@@ -87,8 +160,9 @@ void ClassImpl::callMethod(INTERNAL_FUNCTION_PARAMETERS)
     ClassBase *meta = data->self->_base;
     
     // the data structure was allocated by ourselves in the getMethod or 
-    // getStaticMethod functions, we no longer need it now
-    efree(data);
+    // getStaticMethod functions, we no longer need it now (unless it is
+    // one of the persistent records that are reused for every call)
+    if (func->fn_flags & ZEND_ACC_CALL_VIA_HANDLER) efree(data);
 
     // the function could throw an exception
     try
@@ -132,9 +206,10 @@ void ClassImpl::callInvoke(INTERNAL_FUNCTION_PARAMETERS)
     // get self reference
     ClassBase *meta = data->self->_base;
 
-    // the data structure was allocated by ourselves in the getMethod or 
-    // getStaticMethod functions, we no longer need it now
-    efree(data);
+    // the data structure was allocated by ourselves in the getClosure
+    // function, we no longer need it now (unless it is the persistent 
+    // record that is reused for every call)
+    if (data->func.fn_flags & ZEND_ACC_CALL_VIA_HANDLER) efree(data);
 
     // the function could throw an exception
     try
@@ -197,6 +272,22 @@ zend_function *ClassImpl::getMethod(zval **object_ptr, char *method_name, int me
     
     // retrieve the class entry linked to this object
     auto *entry = zend_get_class_entry(*object_ptr TSRMLS_CC);
+    
+    // retrieve our meta information
+    ClassImpl *impl = ObjectImpl::find(*object_ptr TSRMLS_CC)->meta();
+
+#ifndef ZTS
+    // for our own classes we have persistent records that can be reused (this is
+    // not possible for user space classes that extend from our class, because
+    // the record holds the scope, and it is not possible in multi threaded
+    // environments, because the cache is not protected against concurrent access)
+    if (entry == impl->_entry)
+    {
+        // look up the record (this fails when there are too many of them)
+        auto *data = impl->forwarder(method_name, method_len, false);
+        if (data) return (zend_function *)data;
+    }
+#endif
 
     // this is peculiar behavior of the zend engine, we first are going to dynamically 
     // allocate memory holding all the properties of the __call method (we initially
@@ -205,21 +296,9 @@ zend_function *ClassImpl::getMethod(zval **object_ptr, char *method_name, int me
     // it is strange to allocate and free memory in one and the same method call (free()
     // call happens in call_method())
     auto *data = (CallData *)emalloc(sizeof(CallData));
-    auto *function = &data->func;
     
     // we're going to set all properties
-    function->type = ZEND_INTERNAL_FUNCTION;
-    function->module = nullptr;
-    function->handler = &ClassImpl::callMethod;
-    function->arg_info = nullptr;
-    function->num_args = 0;
-    function->required_num_args = 0;
-    function->scope = entry;
-    function->fn_flags = ZEND_ACC_CALL_VIA_HANDLER;
-    function->function_name = method_name;
-    
-    // store pointer to ourselves
-    data->self = self(entry);
+    fill(data, &ClassImpl::callMethod, entry, method_name, ZEND_ACC_CALL_VIA_HANDLER, impl);
     
     // done (cast to zend_function* is allowed, because a zend_function is a union
     // that has one member being a zend_internal_function)
@@ -247,30 +326,73 @@ zend_function *ClassImpl::getStaticMethod(zend_class_entry *entry, char* method,
     // did the default implementation do anything?
     if (defaultFunction) return defaultFunction;
 
+    // retrieve our meta information
+    ClassImpl *impl = find(entry);
+
+#ifndef ZTS
+    // for our own classes we reuse persistent records (see getMethod())
+    if (entry == impl->_entry)
+    {
+        // look up the record (this fails when there are too many of them)
+        auto *data = impl->forwarder(method, method_len, true);
+        if (data) return (zend_function *)data;
+    }
+#endif
+
     // just like we did in getMethod() (see comment there) we are going to dynamically
     // allocate data holding information about the function
     auto *data = (CallData *)emalloc(sizeof(CallData));
-    auto *function = &data->func;
     
     // we're going to set all properties
-    function->type = ZEND_INTERNAL_FUNCTION;
-    function->module = nullptr;
-    function->handler = ClassImpl::callMethod;
-    function->arg_info = nullptr;
-    function->num_args = 0;
-    function->required_num_args = 0;
-    function->scope = nullptr;
-    function->fn_flags = ZEND_ACC_CALL_VIA_HANDLER;
-    function->function_name = method;
-    
-    // store pointer to ourselves
-    data->self = self(entry);
+    fill(data, &ClassImpl::callMethod, nullptr, method, ZEND_ACC_CALL_VIA_HANDLER, impl);
     
     // done (cast to zend_function* is allowed, because a zend_function is a union
     // that has one member being a zend_internal_function)
     return (zend_function *)data;
 }
 
+/**
+ *  Retrieve a persistent function record that forwards a call to the
+ *  __call() or __callStatic() method
+ *  @param  name        Name of the method
+ *  @param  size        Size of the name
+ *  @param  statically  Is the method called statically?
+ *  @return CallData
+ */
+CallData *ClassImpl::forwarder(const char *name, int size, bool statically)
+{
+    // the table to look in
+    HashTable *table = statically ? &_staticForwarders : &_forwarders;
+
+    // the record that was found
+    CallData **result;
+    
+    // do we already have a record for this method name? (the size in the
+    // hash table includes the terminating null character)
+    if (zend_hash_find(table, name, size + 1, (void **)&result) == SUCCESS) return *result;
+    
+    // the table should not grow without limits
+    if (zend_hash_num_elements(table) >= maxForwarders) return nullptr;
+    
+    // allocate persistent memory for the record and a copy of the name (the
+    // name must remain valid as long as the record exists)
+    auto *data = (CallData *)pemalloc(sizeof(CallData) + size + 1, 1);
+    char *copy = (char *)(data + 1);
+    memcpy(copy, name, size);
+    copy[size] = '\0';
+    
+    // fill the record (static records do not have a scope, just like the
+    // records that are allocated for every call, the engine then decides
+    // whether the call gets an object or not)
+    fill(data, &ClassImpl::callMethod, statically ? nullptr : _entry, copy, ZEND_ACC_PUBLIC, this);
+    
+    // store in the table
+    zend_hash_add(table, copy, size + 1, &data, sizeof(CallData *), nullptr);
+    
+    // done
+    return data;
+}
+
 /**
  *  Method that returns the closure -- this is the __invoke handler!
  *  @param  object
@@ -291,39 +413,63 @@ int ClassImpl::getClosure(zval *object, zend_class_entry **entry_ptr, zend_funct
     
     // retrieve the class entry linked to this object
     auto *entry = zend_get_class_entry(object TSRMLS_CC);
+    
+    // retrieve our meta information
+    ClassImpl *impl = ObjectImpl::find(object TSRMLS_CC)->meta();
+    
+    // the object_ptr should be filled with the object on which the method is 
+    // called (otherwise the Zend engine tries to call the method statically)
+    *object_ptr = object;
+
+#ifndef ZTS
+    // for our own classes we reuse a persistent record (see getMethod())
+    if (entry == impl->_entry)
+    {
+        // create the record the first time
+        if (!impl->_invoker)
+        {
+            // allocate persistent memory
+            impl->_invoker = (CallData *)pemalloc(sizeof(CallData), 1);
+            
+            // we're going to set all properties
+            fill(impl->_invoker, &ClassImpl::callInvoke, entry, nullptr, ZEND_ACC_PUBLIC, impl);
+        }
+        
+        // reuse the record
+        *func = (zend_function *)impl->_invoker;
+        
+        // done
+        return SUCCESS;
+    }
+#endif
 
     // just like we did for getMethod(), we're going to dynamically allocate memory
     // with all information about the function
     auto *data = (CallData *)emalloc(sizeof(CallData));
-    auto *function = &data->func;
     
     // we're going to set all properties
-    function->type = ZEND_INTERNAL_FUNCTION;
-    function->module = nullptr;
-    function->handler = &ClassImpl::callInvoke;
-    function->arg_info = nullptr;
-    function->num_args = 0;
-    function->required_num_args = 0;
-    function->scope = entry;
-    function->fn_flags = ZEND_ACC_CALL_VIA_HANDLER;
-    function->function_name = nullptr;
-    
-    // store pointer to ourselves
-    data->self = self(entry);
+    fill(data, &ClassImpl::callInvoke, entry, nullptr, ZEND_ACC_CALL_VIA_HANDLER, impl);
     
     // assign this dynamically allocated variable to the func parameter
     // the case is ok, because zend_internal_function is a member of the
     // zend_function union
     *func = (zend_function *)data;
- 
-    // the object_ptr should be filled with the object on which the method is 
-    // called (otherwise the Zend engine tries to call the method statically)
-    *object_ptr = object;
     
     // done
     return SUCCESS;
 };
 
+/**
+ *  Add a method that is implemented by __call() or __callStatic()
+ *  @param  name        Name of the method
+ *  @param  flags       Optional flags (Php::Static for __callStatic())
+ */
+void ClassImpl::dynamicMethod(const char *name, int flags)
+{
+    // add the method
+    _methods.push_back(std::make_shared<MagicMethod>(name, this, flags & (MethodModifiers | Static)));
+}
+
 /**
  *  Retrieve pointer to our own object handlers
  *  @return zend_object_handlers
@@ -371,6 +517,13 @@ zend_object_handlers *ClassImpl::objectHandlers()
     // method to compare two objects
     handlers.compare_objects = &ClassImpl::compare;
     
+#if PHP_VERSION_ID < 50399
+    // on php 5.3 the properties table is only allocated when it is needed,
+    // so the handlers that access the table directly must be overridden
+    handlers.get_properties = &ClassImpl::getProperties;
+    handlers.get_property_ptr_ptr = &ClassImpl::getPropertyPointer;
+#endif
+    
     // remember that object is now initialized
     initialized = true;
     
@@ -378,6 +531,42 @@ zend_object_handlers *ClassImpl::objectHandlers()
     return &handlers;
 }
 
+#if PHP_VERSION_ID < 50399
+
+/**
+ *  Function that is called to get access to all properties of an object
+ *  @param  object
+ *  @param  tsrm_ls
+ *  @return HashTable
+ */
+HashTable *ClassImpl::getProperties(zval *object TSRMLS_DC)
+{
+    // the table is allocated when it is needed for the first time
+    ObjectImpl::materialize(object TSRMLS_CC);
+    
+    // call the default
+    return std_object_handlers.get_properties(object TSRMLS_CC);
+}
+
+/**
+ *  Function that is called to get a pointer to a property, when a property
+ *  is modified in place (for example with $object->x[] = 1)
+ *  @param  object
+ *  @param  member
+ *  @param  tsrm_ls
+ *  @return zval**
+ */
+zval **ClassImpl::getPropertyPointer(zval *object, zval *member TSRMLS_DC)
+{
+    // the table is allocated when it is needed for the first time
+    ObjectImpl::materialize(object TSRMLS_CC);
+    
+    // call the default
+    return std_object_handlers.get_property_ptr_ptr(object, member TSRMLS_CC);
+}
+
+#endif
+
 /**
  *  Function to compare two objects
  *  @param  val1
@@ -396,12 +585,16 @@ int ClassImpl::compare(zval *val1, zval *val2 TSRMLS_DC)
         // other object must be of the same type
         if (entry != zend_get_class_entry(val2 TSRMLS_CC)) throw NotImplemented();
 
+        // retrieve the implementation objects
+        ObjectImpl *impl1 = ObjectImpl::find(val1 TSRMLS_CC);
+        ObjectImpl *impl2 = ObjectImpl::find(val2 TSRMLS_CC);
+
         // we need the C++ class meta-information object
-        ClassBase *meta = self(entry)->_base;
+        ClassBase *meta = impl1->meta()->_base;
         
         // get the base objects
-        Base *object1 = ObjectImpl::find(val1 TSRMLS_CC)->object();
-        Base *object2 = ObjectImpl::find(val2 TSRMLS_CC)->object();
+        Base *object1 = impl1->object();
+        Base *object2 = impl2->object();
         
         // run the compare method
         return meta->callCompare(object1, object2);
@@ -411,6 +604,10 @@ int ClassImpl::compare(zval *val1, zval *val2 TSRMLS_DC)
         // it was not implemented, do we have a default?
         if (!std_object_handlers.compare_objects) return 1;
         
+        // the default compares the properties tables
+        ObjectImpl::materialize(val1 TSRMLS_CC);
+        ObjectImpl::materialize(val2 TSRMLS_CC);
+        
         // call default
         return std_object_handlers.compare_objects(val1, val2 TSRMLS_CC);
     }
@@ -435,14 +632,14 @@ int ClassImpl::compare(zval *val1, zval *val2 TSRMLS_DC)
  */
 int ClassImpl::cast(zval *val, zval *retval, int type TSRMLS_DC)
 {
+    // retrieve the implementation object
+    ObjectImpl *impl = ObjectImpl::find(val TSRMLS_CC);
+
     // get the base c++ object
-    Base *object = ObjectImpl::find(val TSRMLS_CC)->object();
+    Base *object = impl->object();
     
-    // retrieve the class entry linked to this object
-    auto *entry = zend_get_class_entry(val TSRMLS_CC);
-
     // we need the C++ class meta-information object
-    ClassBase *meta = self(entry)->_base;
+    ClassBase *meta = impl->meta()->_base;
     
     // retval it not yet initialized --- and again feelings of disbelief,
     // frustration, wonder and anger come up when you see that there are not two
@@ -508,13 +705,13 @@ zend_object_value ClassImpl::cloneObject(zval *val TSRMLS_DC)
     // retrieve the class entry linked to this object
     auto *entry = zend_get_class_entry(val TSRMLS_CC);
 
-    // we need the C++ class meta-information object
-    ClassImpl *impl = self(entry);
-    ClassBase *meta = impl->_base;
-
     // retrieve the old object, which we are going to copy
     ObjectImpl *old_object = ObjectImpl::find(val TSRMLS_CC);
 
+    // we need the C++ class meta-information object
+    ClassImpl *impl = old_object->meta();
+    ClassBase *meta = impl->_base;
+
     // create a new base c++ object
     auto *cpp = meta->clone(old_object->object());
     
@@ -529,18 +726,30 @@ zend_object_value ClassImpl::cloneObject(zval *val TSRMLS_DC)
     // set the handlers
     result.handlers = impl->objectHandlers();
     
-    // store the object
-    ObjectImpl *new_object = new ObjectImpl(entry, cpp TSRMLS_CC);
+    // store the object (this already shares the declared properties with
+    // the old object, if the old object has no dynamic properties)
+    ObjectImpl *new_object = new ObjectImpl(entry, cpp, impl, old_object TSRMLS_CC);
 
     // store the object in the object cache
     result.handle = new_object->handle();
     
-    // clone the members (this will also call the __clone() function if the user
-    // had registered that as a visible method)
-    zend_objects_clone_members(new_object->php(), result, old_object->php(), Z_OBJ_HANDLE_P(val) TSRMLS_CC);
+    // if the old object has dynamic properties (or on php 5.3: if it has a
+    // properties table at all), or when a __clone() method was defined in user
+    // space, we need the engine to copy the members (this will also call the 
+    // __clone() function if the user had registered that as a visible method)
+    if (old_object->php()->properties || entry->clone)
+    {
+        // the properties tables are copied, so they must exist
+        old_object->materialize();
+        new_object->materialize();
+    
+        // clone the members
+        zend_objects_clone_members(new_object->php(), result, old_object->php(), Z_OBJ_HANDLE_P(val) TSRMLS_CC);
+    }
     
-    // was a custom clone method installed? If not we call the magic c++ __clone method
-    if (!entry->clone) meta->callClone(cpp);
+    // was a custom clone method installed? If not we call the magic c++ __clone 
+    // method, but only if the class has overridden it
+    if (!entry->clone && impl->_cloneMethod) meta->callClone(cpp);
     
     // done
     return result;
@@ -558,8 +767,11 @@ zend_object_value ClassImpl::cloneObject(zval *val TSRMLS_DC)
  */
 int ClassImpl::countElements(zval *object, long *count TSRMLS_DC)
 {
+    // retrieve the object
+    ObjectImpl *obj = ObjectImpl::find(object TSRMLS_CC);
+
     // does it implement the countable interface?
-    Countable *countable = dynamic_cast<Countable*>(ObjectImpl::find(object TSRMLS_CC)->object());
+    Countable *countable = obj->meta()->countable(obj->object());
 
     // if it does not implement the Countable interface, we rely on the default implementation
     if (countable) 
@@ -592,6 +804,49 @@ int ClassImpl::countElements(zval *object, long *count TSRMLS_DC)
     }
 }
 
+/**
+ *  Convert the offset of a dimension into an integer index
+ *  @param  offset          The offset
+ *  @param  loose           Should offsets that are not integers be converted too?
+ *  @param  index           Will be filled with the index
+ *  @return bool            Is the offset an index?
+ */
+static bool toIndex(zval *offset, bool loose, int64_t &index)
+{
+    // there is no offset for the [] operator
+    if (!offset) return false;
+    
+    // integer offsets are the normal case
+    if (Z_TYPE_P(offset) == IS_LONG)
+    {
+        // no conversion necessary
+        index = Z_LVAL_P(offset);
+        return true;
+    }
+    
+    // other offsets are only converted if they can not be passed to an other interface
+    if (!loose) return false;
+    
+    // check the type (doubles are converted the same way as the engine does,
+    // which is also safe for NaN, infinity and doubles that are out of range)
+    switch (Z_TYPE_P(offset)) {
+    case IS_DOUBLE: index = zend_dval_to_lval(Z_DVAL_P(offset)); return true;
+    case IS_BOOL:   index = Z_BVAL_P(offset); return true;
+    case IS_STRING: {
+        // the string could hold a number
+        long lval; double dval;
+        
+        // check the string
+        switch (is_numeric_string(Z_STRVAL_P(offset), Z_STRLEN_P(offset), &lval, &dval, 0)) {
+        case IS_LONG:   index = lval; return true;
+        case IS_DOUBLE: index = zend_dval_to_lval(dval); return true;
+        default:        return false;
+        }
+    }
+    default:        return false;
+    }
+}
+
 /**
  *  Function that is called when the object is used as an array in PHP
  * 
@@ -624,8 +879,34 @@ zval *ClassImpl::readDimension(zval *object, zval *offset, int type TSRMLS_DC)
     // that is in most cases simply impossible.
     
      
-    // does it implement the arrayaccess interface?
-    ArrayAccess *arrayaccess = dynamic_cast<ArrayAccess*>(ObjectImpl::find(object TSRMLS_CC)->object());
+    // retrieve the object
+    ObjectImpl *obj = ObjectImpl::find(object TSRMLS_CC);
+
+    // does it implement the arrayaccess or indexaccess interface?
+    ArrayAccess *arrayaccess = obj->meta()->arrayAccess(obj->object());
+    IndexAccess *indexaccess = obj->meta()->indexAccess(obj->object());
+    
+    // the offset as integer
+    int64_t index;
+    
+    // integer offsets are passed to the IndexAccess interface without wrapping them
+    if (indexaccess && toIndex(offset, !arrayaccess, index))
+    {
+        // the C++ code may throw an exception
+        try
+        {
+            // IndexAccess is implemented, call function
+            return toZval(indexaccess->indexGet(index), type);
+        }
+        catch (Exception &exception)
+        {
+            // process the exception (send it to user space)
+            process(exception TSRMLS_CC);
+            
+            // unreachable
+            return Value(nullptr).detach();
+        }
+    }
     
     // if it does not implement the ArrayAccess interface, we rely on the default implementation
     if (arrayaccess) 
@@ -669,8 +950,36 @@ zval *ClassImpl::readDimension(zval *object, zval *offset, int type TSRMLS_DC)
  */
 void ClassImpl::writeDimension(zval *object, zval *offset, zval *value TSRMLS_DC)
 {
-    // does it implement the arrayaccess interface?
-    ArrayAccess *arrayaccess = dynamic_cast<ArrayAccess*>(ObjectImpl::find(object TSRMLS_CC)->object());
+    // retrieve the object
+    ObjectImpl *obj = ObjectImpl::find(object TSRMLS_CC);
+
+    // does it implement the arrayaccess or indexaccess interface?
+    ArrayAccess *arrayaccess = obj->meta()->arrayAccess(obj->object());
+    IndexAccess *indexaccess = obj->meta()->indexAccess(obj->object());
+    
+    // the offset as integer
+    int64_t index;
+    
+    // integer offsets are passed to the IndexAccess interface without wrapping them,
+    // and so is the [] operator when there is no ArrayAccess interface
+    if (indexaccess && (toIndex(offset, !arrayaccess, index) || (!offset && !arrayaccess)))
+    {
+        // method may throw an exception
+        try
+        {
+            // set or append the value
+            if (offset) indexaccess->indexSet(index, value);
+            else indexaccess->indexAppend(value);
+        }
+        catch (Exception &exception)
+        {
+            // process the exception (send it to user space)
+            process(exception TSRMLS_CC);
+        }
+        
+        // done
+        return;
+    }
     
     // if it does not implement the ArrayAccess interface, we rely on the default implementation
     if (arrayaccess) 
@@ -711,8 +1020,37 @@ void ClassImpl::writeDimension(zval *object, zval *offset, zval *value TSRMLS_DC
  */
 int ClassImpl::hasDimension(zval *object, zval *member, int check_empty TSRMLS_DC)
 {
-    // does it implement the arrayaccess interface?
-    ArrayAccess *arrayaccess = dynamic_cast<ArrayAccess*>(ObjectImpl::find(object TSRMLS_CC)->object());
+    // retrieve the object
+    ObjectImpl *obj = ObjectImpl::find(object TSRMLS_CC);
+
+    // does it implement the arrayaccess or indexaccess interface?
+    ArrayAccess *arrayaccess = obj->meta()->arrayAccess(obj->object());
+    IndexAccess *indexaccess = obj->meta()->indexAccess(obj->object());
+    
+    // the offset as integer
+    int64_t index;
+    
+    // integer offsets are passed to the IndexAccess interface without wrapping them
+    if (indexaccess && toIndex(member, !arrayaccess, index))
+    {
+        // user implemented callbacks could throw an exception
+        try
+        {
+            // check if the element exists
+            if (!indexaccess->indexExists(index)) return false;
+            
+            // for isset() we are ready, empty() also checks the value
+            return check_empty ? indexaccess->indexGet(index).boolValue() : true;
+        }
+        catch (Exception &exception)
+        {
+            // process the exception (send it to user space)
+            process(exception TSRMLS_CC);
+            
+            // unreachable
+            return false;
+        }
+    }
     
     // if it does not implement the ArrayAccess interface, we rely on the default implementation
     if (arrayaccess) 
@@ -761,8 +1099,34 @@ int ClassImpl::hasDimension(zval *object, zval *member, int check_empty TSRMLS_D
  */
 void ClassImpl::unsetDimension(zval *object, zval *member TSRMLS_DC)
 {
-    // does it implement the arrayaccess interface?
-    ArrayAccess *arrayaccess = dynamic_cast<ArrayAccess*>(ObjectImpl::find(object TSRMLS_CC)->object());
+    // retrieve the object
+    ObjectImpl *obj = ObjectImpl::find(object TSRMLS_CC);
+
+    // does it implement the arrayaccess or indexaccess interface?
+    ArrayAccess *arrayaccess = obj->meta()->arrayAccess(obj->object());
+    IndexAccess *indexaccess = obj->meta()->indexAccess(obj->object());
+    
+    // the offset as integer
+    int64_t index;
+    
+    // integer offsets are passed to the IndexAccess interface without wrapping them
+    if (indexaccess && toIndex(member, !arrayaccess, index))
+    {
+        // user implemented code could throw an exception
+        try
+        {
+            // remove the element
+            indexaccess->indexUnset(index);
+        }
+        catch (Exception &exception)
+        {
+            // process the exception (send it to user space)
+            process(exception TSRMLS_CC);
+        }
+        
+        // done
+        return;
+    }
     
     // if it does not implement the ArrayAccess interface, we rely on the default implementation
     if (arrayaccess) 
@@ -813,6 +1177,71 @@ zval *ClassImpl::toZval(Value &&value, int type)
     return Value(value.detach(), true).detach();
 }
 
+/**
+ *  Find a property with callbacks
+ * 
+ *  The lookup uses the hash value that the Zend engine already calculated
+ *  for the property name, and stores the result in the runtime cache slot of
+ *  the opline, so that subsequent lookups from the same line of PHP code do not
+ *  need a hash lookup at all.
+ * 
+ *  @param  entry       Class entry of the object
+ *  @param  name        Name of the property
+ *  @param  key         Literal with the precalculated hash value and cache slot
+ *  @param  tsrm_ls
+ *  @return Property    The property, or nullptr when it is not a property with callbacks
+ */
+#if PHP_VERSION_ID >= 50400
+Property *ClassImpl::findProperty(zend_class_entry *entry, zval *name, const zend_literal *key TSRMLS_DC)
+#else
+Property *ClassImpl::findProperty(zend_class_entry *entry, zval *name TSRMLS_DC)
+#endif
+{
+    // if there are no properties with callbacks, there is nothing to look for
+    if (zend_hash_num_elements(&_accessors) == 0) return nullptr;
+    
+    // the property that is found
+    Property **result;
+
+    // property names are normally strings, other values are converted first
+    if (Z_TYPE_P(name) != IS_STRING)
+    {
+        // convert to string
+        std::string str(Value(name).stringValue());
+        
+        // look up the property
+        return zend_hash_find(&_accessors, str.c_str(), str.size() + 1, (void **)&result) == SUCCESS ? *result : nullptr;
+    }
+
+#if PHP_VERSION_ID >= 50400
+    // without a literal we have to calculate the hash ourselves
+    if (!key) return zend_hash_find(&_accessors, Z_STRVAL_P(name), Z_STRLEN_P(name) + 1, (void **)&result) == SUCCESS ? *result : nullptr;
+
+    // the runtime cache slot is shared with the default handlers, which store
+    // the class entry in it. To make sure that our entries are never mistaken
+    // for theirs (and the other way around), we use a tagged class entry pointer
+    // that can never be a valid class entry
+    auto *tag = (zend_class_entry *)((char *)entry + 1);
+    
+    // was the property already stored in the runtime cache?
+    auto *cached = (Property *)CACHED_POLYMORPHIC_PTR(key->cache_slot, tag);
+    if (cached) return cached;
+    
+    // look up the property, reusing the hash value of the literal
+    if (zend_hash_quick_find(&_accessors, Z_STRVAL_P(name), Z_STRLEN_P(name) + 1, key->hash_value, (void **)&result) != SUCCESS) return nullptr;
+    
+    // store in the runtime cache (only properties that were found, because
+    // an empty cache slot can not be distinguished from a failed lookup)
+    CACHE_POLYMORPHIC_PTR(key->cache_slot, tag, *result);
+    
+    // done
+    return *result;
+#else
+    // look up the property
+    return zend_hash_find(&_accessors, Z_STRVAL_P(name), Z_STRLEN_P(name) + 1, (void **)&result) == SUCCESS ? *result : nullptr;
+#endif
+}
+
 /**
  *  Function that is called when a property is read
  *  @param  object
@@ -846,35 +1275,42 @@ zval *ClassImpl::readProperty(zval *object, zval *name, int type, const zend_lit
     // that is in most cases simply impossible.
 
     // retrieve the object and class
-    Base *base = ObjectImpl::find(object TSRMLS_CC)->object();
+    ObjectImpl *obj = ObjectImpl::find(object TSRMLS_CC);
+    Base *base = obj->object();
     
     // retrieve the class entry linked to this object
     auto *entry = zend_get_class_entry(object TSRMLS_CC);
 
     // we need the C++ class meta-information object
-    ClassImpl *impl = self(entry);
+    ClassImpl *impl = obj->meta();
     ClassBase *meta = impl->_base;
     
     // the default implementation throws an exception, so by catching 
     // the exception we know if the object was implemented by the user or not
     try
     {
-        // convert name to a Value object
-        Value key(name);
-        
         // is it a property with a callback?
-        auto iter = impl->_properties.find(key);
+#if PHP_VERSION_ID >= 50400
+        Property *property = impl->findProperty(entry, name, key TSRMLS_CC);
+#else
+        Property *property = impl->findProperty(entry, name TSRMLS_CC);
+#endif
         
         // was it found?
-        if (iter == impl->_properties.end())
+        if (!property)
         {
             // retrieve value from the __get method
-            return toZval(meta->callGet(base, key), type);
+            return toZval(meta->callGet(base, name), type);
+        }
+        else if (property->bound())
+        {
+            // data members are converted straight into a zval
+            return property->read(base);
         }
         else
         {
             // get the value
-            return toZval(iter->second->get(base), type);
+            return toZval(property->get(base), type);
         }
     }
     catch (const NotImplemented &exception)
@@ -882,6 +1318,9 @@ zval *ClassImpl::readProperty(zval *object, zval *name, int type, const zend_lit
         // __get() function was not overridden by the user
         if (!std_object_handlers.read_property) return nullptr;
         
+        // the default handler needs the properties table
+        ObjectImpl::materialize(object TSRMLS_CC);
+        
         // call default
 #if PHP_VERSION_ID < 50399
         return std_object_handlers.read_property(object, name, type TSRMLS_CC);
@@ -920,38 +1359,40 @@ void ClassImpl::writeProperty(zval *object, zval *name, zval *value, const zend_
 #endif
 {
     // retrieve the object and class
-    Base *base = ObjectImpl::find(object TSRMLS_CC)->object();
+    ObjectImpl *obj = ObjectImpl::find(object TSRMLS_CC);
+    Base *base = obj->object();
     
     // retrieve the class entry linked to this object
     auto *entry = zend_get_class_entry(object TSRMLS_CC);
 
     // we need the C++ class meta-information object
-    ClassImpl *impl = self(entry);
+    ClassImpl *impl = obj->meta();
     ClassBase *meta = impl->_base;
 
     // the default implementation throws an exception, if we catch that
     // we know for sure that the user has not overridden the __set method
     try
     {
-        // wrap the name
-        Value key(name);
-        
         // check if the property has a callback
-        auto iter = impl->_properties.find(key);
+#if PHP_VERSION_ID >= 50400
+        Property *property = impl->findProperty(entry, name, key TSRMLS_CC);
+#else
+        Property *property = impl->findProperty(entry, name TSRMLS_CC);
+#endif
         
         // is it set?
-        if (iter == impl->_properties.end())
+        if (!property)
         {
             // use the __set method
-            meta->callSet(base, key, value);
+            meta->callSet(base, name, value);
         }
         else
         {
             // check if it could be set
-            if (iter->second->set(base, value)) return;
+            if (property->write(base, value)) return;
             
             // read-only property
-            zend_error(E_ERROR, "Unable to write to read-only property %s", (const char *)key);
+            zend_error(E_ERROR, "Unable to write to read-only property %s", Value(name).rawValue());
         }
     }
     catch (const NotImplemented &exception)
@@ -959,6 +1400,9 @@ void ClassImpl::writeProperty(zval *object, zval *name, zval *value, const zend_
         // __set() function was not overridden by user, check if there is a default
         if (!std_object_handlers.write_property) return;
         
+        // the default handler needs the properties table
+        ObjectImpl::materialize(object TSRMLS_CC);
+        
         // call the default
 #if PHP_VERSION_ID < 50399
         std_object_handlers.write_property(object, name, value TSRMLS_CC);
@@ -1005,29 +1449,34 @@ int ClassImpl::hasProperty(zval *object, zval *name, int has_set_exists, const z
     try
     {
         // get the cpp object
-        Base *base = ObjectImpl::find(object TSRMLS_CC)->object();
+        ObjectImpl *obj = ObjectImpl::find(object TSRMLS_CC);
+        Base *base = obj->object();
         
         // retrieve the class entry linked to this object
         auto *entry = zend_get_class_entry(object TSRMLS_CC);
 
         // we need the C++ class meta-information object
-        ClassImpl *impl = self(entry);
+        ClassImpl *impl = obj->meta();
         ClassBase *meta = impl->_base;
         
-        // convert the name to a Value object
-        Value key(name);
-
         // check if this is a callback property
-        if (impl->_properties.find(key) != impl->_properties.end()) return true;
+#if PHP_VERSION_ID >= 50400
+        if (impl->findProperty(entry, name, key TSRMLS_CC)) return true;
+#else
+        if (impl->findProperty(entry, name TSRMLS_CC)) return true;
+#endif
+
+        // convert the name to a Value object
+        Value property(name);
 
         // call the C++ object
-        if (!meta->callIsset(base, key)) return false;
+        if (!meta->callIsset(base, property)) return false;
         
         // property exists, but what does the user want to know
         if (has_set_exists == 2) return true;
         
         // we have to retrieve the property
-        Value value = meta->callGet(base, key);
+        Value value = meta->callGet(base, property);
         
         // should we check on NULL?
         switch (has_set_exists) {
@@ -1040,6 +1489,9 @@ int ClassImpl::hasProperty(zval *object, zval *name, int has_set_exists, const z
         // __isset was not implemented, do we have a default?
         if (!std_object_handlers.has_property) return 0;
 
+        // the default handler needs the properties table
+        ObjectImpl::materialize(object TSRMLS_CC);
+        
         // call default
 #if PHP_VERSION_ID < 50399
         return std_object_handlers.has_property(object, name, has_set_exists TSRMLS_CC);
@@ -1082,25 +1534,29 @@ void ClassImpl::unsetProperty(zval *object, zval *member, const zend_literal *ke
         auto *entry = zend_get_class_entry(object TSRMLS_CC);
 
         // we need the C++ class meta-information object
-        ClassImpl *impl = self(entry);
-        
-        // property name
-        Value name(member);
+        ClassImpl *impl = ObjectImpl::find(object TSRMLS_CC)->meta();
         
         // is this a callback property?
-        auto iter = impl->_properties.find(name);
+#if PHP_VERSION_ID >= 50400
+        Property *property = impl->findProperty(entry, member, key TSRMLS_CC);
+#else
+        Property *property = impl->findProperty(entry, member TSRMLS_CC);
+#endif
         
         // if the property does not exist, we forward to the __unset
-        if (iter == impl->_properties.end()) impl->_base->callUnset(ObjectImpl::find(object TSRMLS_CC)->object(), member);
+        if (!property) return impl->_base->callUnset(ObjectImpl::find(object TSRMLS_CC)->object(), member);
         
         // callback properties cannot be unset
-        zend_error(E_ERROR, "Property %s can not be unset", (const char *)name);
+        zend_error(E_ERROR, "Property %s can not be unset", Value(member).rawValue());
     }
     catch (const NotImplemented &exception)
     {
         // __unset was not implemented, do we have a default?
         if (!std_object_handlers.unset_property) return;
         
+        // the default handler needs the properties table
+        ObjectImpl::materialize(object TSRMLS_CC);
+        
         // call the default
 #if PHP_VERSION_ID < 50399
         std_object_handlers.unset_property(object, member TSRMLS_CC);
@@ -1129,7 +1585,7 @@ void ClassImpl::destructObject(zend_object *object, zend_object_handle handle TS
     ObjectImpl *obj = ObjectImpl::find(object);
     
     // get meta info
-    ClassImpl *impl = self(object->ce);
+    ClassImpl *impl = obj->meta();
     
     // prevent exceptions
     try
@@ -1160,10 +1616,100 @@ void ClassImpl::freeObject(zend_object *object TSRMLS_DC)
     // allocate memory for the object
     ObjectImpl *obj = ObjectImpl::find(object);
     
+    // get meta info
+    ClassImpl *impl = obj->meta();
+    
+    // one live object less
+    impl->track(-1);
+    
+    // the object can be put in the object pool
+    if (impl->recycle(obj TSRMLS_CC)) return;
+    
     // no longer need it
     obj->destruct(TSRMLS_C);
 }
 
+/**
+ *  Try to put an object that is about to be freed in the object pool
+ *  @param  object          The object to recycle
+ *  @param  tsrm_ls
+ *  @return bool            Was the object put in the pool?
+ */
+bool ClassImpl::recycle(ObjectImpl *object TSRMLS_DC)
+{
+    // objects are only recycled while the pool is open, and when there is a C++ object
+    if (!_poolOpen || !object->object()) return false;
+    
+    // is there still room in the pool?
+    if (_pool.size() >= _poolCapacity)
+    {
+        // the object is going to be destructed after all
+        _statistics.discarded++;
+        
+        // not recycled
+        return false;
+    }
+    
+    // prevent exceptions
+    try
+    {
+        // give the object the opportunity to clear its state
+        _base->callReset(object->object());
+    }
+    catch (Exception &exception)
+    {
+        // a regular Php::Exception was thrown by the extension, pass it on
+        // to PHP user space
+        process(exception TSRMLS_CC);
+        
+        // an object that could not be reset is not recycled
+        _statistics.discarded++;
+        
+        // not recycled
+        return false;
+    }
+    
+    // destruct the zend object, but keep the memory
+    object->release(TSRMLS_C);
+    
+    // the object can be used again
+    _pool.push_back(object);
+    
+    // update the counters
+    _statistics.released++;
+    
+    // done
+    return true;
+}
+
+/**
+ *  Open the object pool, this is called when a request starts
+ */
+void ClassImpl::openPool()
+{
+#ifndef ZTS
+    // the pool is not protected against concurrent access from multiple
+    // threads, so objects are only recycled on single threaded builds
+    _poolOpen = _poolCapacity > 0;
+#endif
+}
+
+/**
+ *  Close the object pool, and deallocate all idle objects, this is called
+ *  when a request ends
+ */
+void ClassImpl::closePool()
+{
+    // objects that are freed from now on should really be freed
+    _poolOpen = false;
+    
+    // deallocate all idle objects
+    for (auto *object : _pool) object->discard();
+    
+    // the pool is empty
+    _pool.clear();
+}
+
 /**
  *  Function that is called when an instance of the class needs to be created.
  *  This function will create the C++ class, and the PHP object
@@ -1174,7 +1720,31 @@ void ClassImpl::freeObject(zend_object *object TSRMLS_DC)
 zend_object_value ClassImpl::createObject(zend_class_entry *entry TSRMLS_DC)
 {
     // we need the C++ class meta-information object
-    ClassImpl *impl = self(entry);
+    ClassImpl *impl = find(entry);
+
+    // the thing we're going to return
+    zend_object_value result;
+    
+    // is there an idle object in the pool that can be recycled?
+    if (!impl->_pool.empty())
+    {
+        // take the object from the pool
+        ObjectImpl *object = impl->_pool.back();
+        impl->_pool.pop_back();
+        
+        // store it in the engine again
+        object->recycle(entry TSRMLS_CC);
+        
+        // update the counters
+        impl->_statistics.reused++;
+        
+        // set the handlers and the object handle
+        result.handlers = impl->objectHandlers();
+        result.handle = object->handle();
+        
+        // done
+        return result;
+    }
 
     // create a new base C++ object
     auto *cpp = impl->_base->construct();
@@ -1182,18 +1752,18 @@ zend_object_value ClassImpl::createObject(zend_class_entry *entry TSRMLS_DC)
     // report error on failure
     if (!cpp) throw Php::Exception(std::string("Unable to instantiate ") + entry->name);
 
-    // the thing we're going to return
-    zend_object_value result;
-    
     // set the handlers
     result.handlers = impl->objectHandlers();
     
     // create the object in the zend engine
-    ObjectImpl *object = new ObjectImpl(entry, cpp TSRMLS_CC);
+    ObjectImpl *object = new ObjectImpl(entry, cpp, impl TSRMLS_CC);
     
     // store the object in the object cache
     result.handle = object->handle();
     
+    // update the counters
+    if (impl->_poolOpen) impl->_statistics.allocated++;
+    
     // done
     return result;
 }
@@ -1211,8 +1781,11 @@ zend_object_iterator *ClassImpl::getIterator(zend_class_entry *entry, zval *obje
     // by-ref is not possible (copied from SPL)
     if (by_ref) throw Php::Exception("Foreach by ref is not possible");
     
+    // retrieve the object
+    ObjectImpl *obj = ObjectImpl::find(object TSRMLS_CC);
+
     // retrieve the traversable object
-    Traversable *traversable = dynamic_cast<Traversable*>(ObjectImpl::find(object TSRMLS_CC)->object());
+    Traversable *traversable = obj->meta()->traversable(obj->object());
     
     // user may throw an exception in the getIterator() function
     try
@@ -1245,8 +1818,44 @@ zend_object_iterator *ClassImpl::getIterator(zend_class_entry *entry, zval *obje
  */
 int ClassImpl::serialize(zval *object, unsigned char **buffer, zend_uint *buf_len, zend_serialize_data *data TSRMLS_DC)
 {
+    // retrieve the object
+    ObjectImpl *obj = ObjectImpl::find(object TSRMLS_CC);
+
+    // does the object write itself into an encoder?
+    StreamSerializable *streamable = obj->meta()->streamSerializable(obj->object());
+    
+    // if it does, the buffer of the encoder is handed over to the engine
+    if (streamable)
+    {
+        // the user function may throw an exception
+        try
+        {
+            // the encoder to write to
+            Encoder encoder;
+            
+            // let the object write itself
+            streamable->serialize(encoder);
+            
+            // hand over the buffer (the engine frees it, just like it frees
+            // the buffers that are created by the default serialize method)
+            *buf_len = encoder.size();
+            *buffer = (unsigned char *)encoder.release();
+            
+            // done
+            return SUCCESS;
+        }
+        catch (Exception &exception)
+        {
+            // send the exception to user space
+            process(exception TSRMLS_CC);
+            
+            // failure
+            return FAILURE;
+        }
+    }
+
     // get the serializable object
-    Serializable *serializable = dynamic_cast<Serializable*>(ObjectImpl::find(object TSRMLS_CC)->object());
+    Serializable *serializable = obj->meta()->serializable(obj->object());
     
     // call the serialize method on the object
     auto value = serializable->serialize();
@@ -1275,8 +1884,39 @@ int ClassImpl::unserialize(zval **object, zend_class_entry *entry, const unsigne
     // create the PHP object
     object_init_ex(*object, entry);
     
+    // retrieve the object
+    ObjectImpl *obj = ObjectImpl::find(*object TSRMLS_CC);
+
+    // does the object read itself from a decoder?
+    StreamSerializable *streamable = obj->meta()->streamSerializable(obj->object());
+    
+    // if it does, it reads straight from the buffer
+    if (streamable)
+    {
+        // the user function, and the decoder, may throw an exception
+        try
+        {
+            // the decoder to read from
+            Decoder decoder((const char *)buffer, buf_len);
+            
+            // let the object read itself
+            streamable->unserialize(decoder);
+            
+            // done
+            return SUCCESS;
+        }
+        catch (Exception &exception)
+        {
+            // send the exception to user space
+            process(exception TSRMLS_CC);
+            
+            // failure
+            return FAILURE;
+        }
+    }
+
     // turn this into a serializale
-    Serializable *serializable = dynamic_cast<Serializable*>(ObjectImpl::find(*object TSRMLS_CC)->object());
+    Serializable *serializable = obj->meta()->serializable(obj->object());
     
     // call the unserialize method on it
     serializable->unserialize((const char *)buffer, buf_len);
@@ -1354,6 +1994,25 @@ void ClassImpl::initialize(ClassBase *base, const std::string &prefix TSRMLS_DC)
     // we need a special constructor
     entry.create_object = &ClassImpl::createObject;
     
+    // find out where the interfaces are located in the C++ objects
+    _traversable.implemented = _base->traversable();
+    _traversable.offset = _base->traversableOffset();
+    _serializable.implemented = _base->serializable();
+    _serializable.offset = _base->serializableOffset();
+    _streamSerializable.implemented = _base->streamSerializable();
+    _streamSerializable.offset = _base->streamSerializableOffset();
+    _countable.implemented = _base->countable();
+    _countable.offset = _base->countableOffset();
+    _arrayAccess.implemented = _base->arrayAccess();
+    _arrayAccess.offset = _base->arrayAccessOffset();
+    _indexAccess.implemented = _base->indexAccess();
+    _indexAccess.offset = _base->indexAccessOffset();
+    _sortable.implemented = _base->sortable();
+    _sortable.offset = _base->sortableOffset();
+    
+    // find out if the class has its own __clone() method
+    _cloneMethod = _base->cloneMethod();
+    
     // register function that is called for static method calls
     entry.get_static_method = &ClassImpl::getStaticMethod;
     
@@ -1361,7 +2020,7 @@ void ClassImpl::initialize(ClassBase *base, const std::string &prefix TSRMLS_DC)
     if (_base->traversable()) entry.get_iterator = &ClassImpl::getIterator;
     
     // for serializable classes, we install callbacks for serializing and unserializing
-    if (_base->serializable())
+    if (_base->serializable() || _base->streamSerializable())
     {
         // add handlers to serialize and unserialize
         entry.serialize = &ClassImpl::serialize;
@@ -1391,35 +2050,28 @@ void ClassImpl::initialize(ClassBase *base, const std::string &prefix TSRMLS_DC)
         else std::cerr << "Derived class " << name() << " is initialized before base class " << interface->name() << ": interface is ignored" << std::endl;
     }
     
-    // allocate doc comment to contain an empty string + a hidden pointer
-    if (!_comment)
-    {
-        // allocate now
-        _comment = (char *)malloc(1 + sizeof(ClassBase *));
-        
-        // empty string on first position
-        _comment[0] = '\0';
-        
-        // this pointer has to be copied to temporary pointer, as &this causes compiler error
-        ClassImpl *impl = this;
-        
-        // copy the 'this' pointer to the doc-comment
-        memcpy(_comment+1, &impl, sizeof(ClassImpl *));
-    }
-    
-    // store pointer to the class in the unused doc_comment member
-#if PHP_VERSION_ID >= 50400    
-    _entry->info.user.doc_comment = _comment;
-#else
-    // and store the wrapper inside the comment
-    _entry->doc_comment = _comment;
-#endif
+    // register the class, so that it can be found back when a handler is called
+    registry()[_entry] = this;
 
     // set access types flags for class
     _entry->ce_flags = (int)_type;
     
     // declare all member variables
     for (auto &member : _members) member->initialize(_entry TSRMLS_CC);
+    
+    // build the index of properties with callbacks
+    for (auto &iter : _properties)
+    {
+        // pointer to the property
+        Property *property = iter.second.get();
+        
+        // store in the index (the size includes the terminating null character)
+        zend_hash_update(&_accessors, iter.first.c_str(), iter.first.size() + 1, &property, sizeof(Property *), nullptr);
+    }
+    
+    // objects of this class are handled by this class only, so the properties
+    // of the base class are added too (unless they are overridden here)
+    if (_parent && _parent->_entry) zend_hash_merge(&_accessors, &_parent->_accessors, nullptr, nullptr, sizeof(Property *), 0);
 }
 
 /**
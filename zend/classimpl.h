@@ -13,6 +13,11 @@
  */
 namespace Php {
 
+/**
+ *  Forward declarations
+ */
+struct CallData;
+
 /**
  *  Class definition
  */
@@ -31,12 +36,6 @@ private:
      */
     std::string _name;
 
-    /**
-     *  The comment for reflexion, with a stored pointer to ourselves
-     *  @var    char*
-     */
-    char *_comment = nullptr;
-
     /**
      *  The class type (this can be values like Php::Abstract and Php::Final)
      *  @var    ClassType
@@ -85,6 +84,121 @@ private:
      */
     std::shared_ptr<ClassImpl> _parent;
 
+    /**
+     *  Max number of idle objects in the object pool (zero when the pool is disabled)
+     *  @var    size_t
+     */
+    size_t _poolCapacity = 0;
+
+    /**
+     *  Is the pool open? Objects are only recycled while a request is running
+     *  @var    bool
+     */
+    bool _poolOpen = false;
+
+    /**
+     *  Released objects that can be recycled
+     *  @var    std::vector
+     */
+    std::vector<ObjectImpl*> _pool;
+
+    /**
+     *  Counters about the object pool
+     *  @var    PoolStatistics
+     */
+    PoolStatistics _statistics;
+
+    /**
+     *  Number of objects that are alive in the engine
+     *  @var    std::atomic
+     */
+    std::atomic<int64_t> _objects{0};
+
+    /**
+     *  Max number of persistent function records for calls to __call(), and
+     *  for static calls
+     *  @var    uint32_t
+     */
+    static const uint32_t maxForwarders = 256;
+
+    /**
+     *  Persistent function records for calls to __call(), indexed by method name
+     *  @var    HashTable
+     */
+    HashTable _forwarders;
+
+    /**
+     *  Persistent function records for calls to __callStatic(), indexed by method name
+     *  @var    HashTable
+     */
+    HashTable _staticForwarders;
+
+    /**
+     *  Persistent function record for calls to __invoke()
+     *  @var    CallData
+     */
+    CallData *_invoker = nullptr;
+
+    /**
+     *  Index of the properties with callbacks, for fast lookups by name
+     *  @var    HashTable
+     */
+    HashTable _accessors;
+
+    /**
+     *  Location of an interface in the C++ objects, relative to the Base class
+     */
+    struct Location
+    {
+        /**
+         *  Is the interface implemented?
+         *  @var    bool
+         */
+        bool implemented = false;
+        
+        /**
+         *  The offset of the interface
+         *  @var    std::ptrdiff_t
+         */
+        std::ptrdiff_t offset = 0;
+    };
+
+    /**
+     *  Location of the interfaces that can be implemented. These are calculated
+     *  when the class is initialized, so that the handlers do not need a
+     *  dynamic_cast to find the interfaces
+     *  @var    Location
+     */
+    Location _traversable;
+    Location _serializable;
+    Location _streamSerializable;
+    Location _countable;
+    Location _arrayAccess;
+    Location _indexAccess;
+    Location _sortable;
+
+    /**
+     *  Does the class have its own __clone() method?
+     *  @var    bool
+     */
+    bool _cloneMethod = false;
+
+    /**
+     *  Find an interface inside a C++ object
+     *  @param  base        The object
+     *  @param  location    Location of the interface
+     *  @return I           The interface, or nullptr when it is not implemented
+     */
+    template <typename I>
+    static I *cast(Base *base, const Location &location)
+    {
+        // interface is not implemented
+        if (!location.implemented) return nullptr;
+        
+        // move the pointer to the interface
+        return reinterpret_cast<I*>(reinterpret_cast<char*>(base) + location.offset);
+    }
+
 
     /**
      *  Retrieve an array of zend_function_entry objects that hold the 
@@ -104,13 +218,56 @@ private:
      */
     static zval *toZval(Value &&value, int type);
 
+    /**
+     *  Try to put an object that is about to be freed in the object pool
+     *  @param  object          The object to recycle
+     *  @param  tsrm_ls
+     *  @return bool            Was the object put in the pool?
+     */
+    bool recycle(ObjectImpl *object TSRMLS_DC);
+
+    /**
+     *  Retrieve a persistent function record that forwards a call to the
+     *  __call() or __callStatic() method
+     * 
+     *  The records are created the first time that a method name is called,
+     *  and are kept until the extension is unloaded. Because the records are
+     *  not marked with ZEND_ACC_CALL_VIA_HANDLER, the engine does not
+     *  deallocate them, and may store them in its own runtime cache.
+     * 
+     *  Scripts can call an unlimited number of different method names, so 
+     *  the number of records is capped. When the cap is reached, a null
+     *  pointer is returned, and the caller has to allocate a record for
+     *  this call only.
+     * 
+     *  @param  name        Name of the method
+     *  @param  size        Size of the name
+     *  @param  statically  Is the method called statically?
+     *  @return CallData    The record, or nullptr if there are too many
+     */
+    CallData *forwarder(const char *name, int size, bool statically);
+
+    /**
+     *  Find a property with callbacks
+     *  @param  entry       Class entry of the object
+     *  @param  name        Name of the property
+     *  @param  key         Literal with the precalculated hash value and cache slot
+     *  @param  tsrm_ls
+     *  @return Property    The property, or nullptr when it is not a property with callbacks
+     */
+#if PHP_VERSION_ID >= 50400
+    Property *findProperty(zend_class_entry *entry, zval *name, const zend_literal *key TSRMLS_DC);
+#else
+    Property *findProperty(zend_class_entry *entry, zval *name TSRMLS_DC);
+#endif
+
 public:
     /**
      *  Constructor
      *  @param  name            Class name
      *  @param  type            Class type
      */
-    ClassImpl(const char *name, ClassType type) : _name(name), _type(type) {}
+    ClassImpl(const char *name, ClassType type);
 
     /**
      *  No copying or moving
@@ -133,6 +290,40 @@ public:
         return _name;
     }
 
+    /**
+     *  Retrieve the C++ class that is registered in the extension
+     *  @return ClassBase
+     */
+    ClassBase *base() const
+    {
+        return _base;
+    }
+
+    /**
+     *  Find the implementation object that belongs to a class entry
+     * 
+     *  For our own classes this is a single lookup, for classes in user space 
+     *  that extend one of our classes, the parents are checked until one of 
+     *  our classes is found
+     * 
+     *  @param  entry       The class entry
+     *  @return ClassImpl   The implementation, or nullptr if the class is not ours
+     */
+    static ClassImpl *find(const zend_class_entry *entry);
+
+    /**
+     *  Find the interfaces inside a C++ object of this class
+     *  @param  base        The object
+     *  @return The interface, or nullptr when it is not implemented
+     */
+    Traversable *traversable(Base *base) const { return cast<Traversable>(base, _traversable); }
+    Serializable *serializable(Base *base) const { return cast<Serializable>(base, _serializable); }
+    StreamSerializable *streamSerializable(Base *base) const { return cast<StreamSerializable>(base, _streamSerializable); }
+    Countable *countable(Base *base) const { return cast<Countable>(base, _countable); }
+    ArrayAccess *arrayAccess(Base *base) const { return cast<ArrayAccess>(base, _arrayAccess); }
+    IndexAccess *indexAccess(Base *base) const { return cast<IndexAccess>(base, _indexAccess); }
+    Sortable *sortable(Base *base) const { return cast<Sortable>(base, _sortable); }
+
     /**
      *  Initialize the class, given its name
      * 
@@ -325,6 +516,19 @@ public:
      */
     static int compare(zval *object1, zval *object2 TSRMLS_DC);
 
+#if PHP_VERSION_ID < 50399
+    /**
+     *  Functions that give access to the properties table (only necessary on
+     *  php 5.3, where the table is allocated when it is first needed)
+     *  @param  object
+     *  @param  member
+     *  @param  tsrm_ls
+     *  @return HashTable|zval**
+     */
+    static HashTable *getProperties(zval *object TSRMLS_DC);
+    static zval **getPropertyPointer(zval *object, zval *member TSRMLS_DC);
+#endif
+
     /**
      *  Methods that are called to serialize/unserialize an object
      *  @param  object      The object to be serialized
@@ -388,6 +592,14 @@ public:
      */
     void method(const char *name, int flags=0, const Arguments &args = {}) { _methods.push_back(std::make_shared<Method>(name, (flags & (MethodModifiers | Static)) | Abstract , args)); }
 
+    /**
+     *  Add a method that is implemented by __call() or __callStatic()
+     * 
+     *  @param  name        Name of the method
+     *  @param  flags       Optional flags (Php::Static for __callStatic())
+     */
+    void dynamicMethod(const char *name, int flags=0);
+
     /**
      *  Add a property to the class
      * 
@@ -423,6 +635,13 @@ public:
     void property(const char *name, const getter_callback_1 &getter, const setter_callback_0 &setter)   { _properties[name] = std::make_shared<Property>(getter,setter); }
     void property(const char *name, const getter_callback_0 &getter, const setter_callback_1 &setter)   { _properties[name] = std::make_shared<Property>(getter,setter); }
     void property(const char *name, const getter_callback_1 &getter, const setter_callback_1 &setter)   { _properties[name] = std::make_shared<Property>(getter,setter); }
+
+    /**
+     *  Set property that is bound to a data member
+     *  @param  name        Name of the property
+     *  @param  member      The data member
+     */
+    void property(const char *name, const std::shared_ptr<DataMember> &member)                         { _properties[name] = std::make_shared<Property>(member); }
     
     /**
      *  Add an interface that is implemented
@@ -436,6 +655,53 @@ public:
      */
     void extends(const std::shared_ptr<ClassImpl> &base) { _parent = base; }
 
+    /**
+     *  Enable the object pool
+     *  @param  capacity    Max number of idle objects to keep
+     */
+    void pool(size_t capacity) { _poolCapacity = capacity; }
+
+    /**
+     *  Retrieve the counters of the object pool
+     *  @return PoolStatistics
+     */
+    PoolStatistics statistics() const
+    {
+        // copy the counters
+        PoolStatistics result(_statistics);
+        
+        // add the current state
+        result.capacity = _poolCapacity;
+        result.idle = _pool.size();
+        
+        // done
+        return result;
+    }
+
+    /**
+     *  Number of objects that are alive in the engine (idle objects in the
+     *  object pool are not counted)
+     *  @return int64_t
+     */
+    int64_t objects() const { return _objects; }
+
+    /**
+     *  Update the number of live objects
+     *  @param  delta       Number of created objects, or negative for freed objects
+     */
+    void track(int delta) { _objects += delta; }
+
+    /**
+     *  Open the object pool, this is called when a request starts
+     */
+    void openPool();
+
+    /**
+     *  Close the object pool, and deallocate all idle objects, this is called
+     *  when a request ends
+     */
+    void closePool();
+
 };
 
 /**
@@ -0,0 +1,71 @@
+/**
+ *  Decoder.cpp
+ *
+ *  Implementation of the Decoder class
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 Copernica BV
+ */
+#include "includes.h"
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Read a PHP value
+ *  @param  depth       Current nesting level of arrays
+ *  @return Value
+ */
+Value Decoder::readValue(int depth)
+{
+    // corrupt data should not be able to exhaust the stack
+    if (depth > 512) throw Exception("Serialized data is nested too deeply");
+    
+    // the type goes first
+    switch ((Type)readByte()) {
+    case Type::Null:    return nullptr;
+    case Type::Numeric: return readInteger();
+    case Type::Float:   return readDouble();
+    case Type::Bool:    return readBool();
+    case Type::String:  {
+        // zero-copy access to the string, the value makes a copy anyway
+        size_t size;
+        const char *data = readString(size);
+        
+        // construct the value
+        return Value(data, size);
+    }
+    case Type::Object:  return call("unserialize", readString());
+    case Type::Array:   {
+        // the number of elements
+        uint64_t count = readUnsigned();
+        
+        // the array to fill
+        Value result(Type::Array);
+        
+        // read all elements
+        for (uint64_t i = 0; i < count; i++)
+        {
+            // the key and the value
+            Value key = readValue(depth + 1);
+            Value value = readValue(depth + 1);
+            
+            // store it
+            if (key.isString()) result.set(key.rawValue(), key.size(), value);
+            else result.set(key.numericValue(), value);
+        }
+        
+        // done
+        return result;
+    }
+    default:            throw Exception("Corrupt serialized data");
+    }
+}
+
+/**
+ *  End namespace
+ */
+}
+
@@ -0,0 +1,109 @@
+/**
+ *  Encoder.cpp
+ *
+ *  Implementation of the Encoder class
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 Copernica BV
+ */
+#include "includes.h"
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Destructor
+ */
+Encoder::~Encoder()
+{
+    // free the buffer if it was not handed over
+    if (_buffer) efree(_buffer);
+}
+
+/**
+ *  Grow the buffer
+ *  @param  size        Number of bytes that are going to be written
+ */
+void Encoder::grow(size_t size)
+{
+    // new capacity, the buffer at least doubles in size
+    size_t capacity = _capacity < 128 ? 256 : _capacity * 2;
+    
+    // and must be big enough for the new data
+    if (capacity < _size + size) capacity = _size + size;
+
+    // reallocate the buffer
+    _buffer = (char *)erealloc(_buffer, capacity);
+    _capacity = capacity;
+}
+
+/**
+ *  Hand over the buffer to the caller
+ *  @return char*
+ */
+char *Encoder::release()
+{
+    // the engine expects a buffer, even when nothing was written
+    if (!_buffer) grow(1);
+
+    // the buffer that is handed over
+    char *result = _buffer;
+
+    // we no longer own it
+    _buffer = nullptr;
+    _size = _capacity = 0;
+
+    // done
+    return result;
+}
+
+/**
+ *  Write a PHP value
+ *  @param  value
+ *  @param  depth       Current nesting level of arrays
+ *  @return Encoder
+ */
+Encoder &Encoder::writeValue(const Value &value, int depth)
+{
+    // the decoder does not accept deeper nesting, and arrays that refer
+    // to themselves would otherwise exhaust the stack
+    if (depth > 512) throw Exception("Value is nested too deeply");
+    
+    // the type of the value
+    Type type = value.type();
+    
+    // types that we do not support are stored as null
+    if (type == Type::Resource || type > Type::String) type = Type::Null;
+    
+    // the type goes first
+    reserve(1);
+    _buffer[_size++] = (char)type;
+
+    // check the type
+    switch (type) {
+    case Type::Numeric: return writeInteger(value.numericValue());
+    case Type::Float:   return writeDouble(value.floatValue());
+    case Type::Bool:    return writeBool(value.boolValue());
+    case Type::String:  return writeString(value.rawValue(), value.size());
+    case Type::Object:  return writeString(call("serialize", value).stringValue());
+    case Type::Array:
+        // the number of elements
+        writeUnsigned(value.size());
+        
+        // and all the keys and values
+        for (auto &iter : value) writeValue(iter.first, depth + 1).writeValue(iter.second, depth + 1);
+        
+        // done
+        return *this;
+        
+    default:            return *this;
+    }
+}
+
+/**
+ *  End namespace
+ */
+}
+
@@ -30,11 +30,23 @@ ZEND_DECLARE_MODULE_GLOBALS(phpcpp)
 
 /**
  *  Function that must be defined to initialize the "globals"
- *  We do not have to initialize anything, but PHP needs to call this
- *  method (crazy)
+ *  The slots for the module globals are allocated when they are accessed
  *  @param  globals
  */
-static void init_globals(zend_phpcpp_globals *globals) {}
+static void init_globals(zend_phpcpp_globals *globals) 
+{
+    // there are no slots yet
+    globals->slots = nullptr;
+    globals->size = 0;
+}
+
+/**
+ *  The "globals" are shared by all extensions that are built with PHP-CPP, so
+ *  they are initialized by the first extension that starts, and destroyed by
+ *  the last extension that stops. This is the number of running extensions.
+ *  @var    size_t
+ */
+static size_t globals_users = 0;
 
 /**
  *  The *startup() and *shutdown() callback functions are passed a module_number
@@ -108,15 +120,28 @@ static ExtensionImpl *find(int number TSRMLS_DC)
  */
 int ExtensionImpl::processStartup(int type, int module_number TSRMLS_DC)
 {
-    // initialize and allocate the "global" variables
-    ZEND_INIT_MODULE_GLOBALS(phpcpp, init_globals, NULL); 
+    // initialize and allocate the "global" variables (these are shared by all extensions)
+    if (globals_users++ == 0) ZEND_INIT_MODULE_GLOBALS(phpcpp, init_globals, &ExtensionImpl::shutdownGlobals);
     
     // get the extension
     auto *extension = find(module_number TSRMLS_CC);
     
+    // register the php.ini settings, this also assigns the initial values to the variables
+    if (!extension->_ini.empty()) zend_register_ini_entries(extension->iniEntries(module_number), module_number TSRMLS_CC);
+    
+    // register the stream wrappers
+    for (auto &wrapper : extension->_wrappers) wrapper->_impl->install(wrapper->protocol().c_str() TSRMLS_CC);
+    
     // initialize the extension
     extension->initialize(TSRMLS_C);
     
+    // start counting the function calls
+    if (extension->_instrument) extension->_data->apply([](const std::string &ns, Function &function) {
+        
+        // count the calls to the function
+        function.instrument();
+    });
+    
     // is the callback registered?
     if (extension->_onStartup) extension->_onStartup();
 
@@ -139,6 +164,28 @@ int ExtensionImpl::processShutdown(int type, int module_number TSRMLS_DC)
     // is the callback registered?
     if (extension->_onShutdown) extension->_onShutdown();
     
+    // one extension less that uses the module globals
+    globals_users--;
+    
+    // the worker pool is shared by all extensions too, so the last extension 
+    // finishes the tasks in the background threads, and stops them
+    if (globals_users == 0) WorkerPool::shutdown();
+    
+    // unregister the stream wrappers
+    for (auto &wrapper : extension->_wrappers) wrapper->_impl->uninstall(wrapper->protocol().c_str() TSRMLS_CC);
+    
+    // forget the php.ini settings
+    if (!extension->_ini.empty()) zend_unregister_ini_entries(module_number TSRMLS_CC);
+    
+    // the last extension destroys the module globals (on a thread safe build
+    // the id is freed, which destroys the globals of all threads, otherwise
+    // the engine would call the destructor when this library is already unloaded)
+#ifdef ZTS
+    if (globals_users == 0) ts_free_id(phpcpp_globals_id);
+#else
+    if (globals_users == 0) shutdownGlobals(&phpcpp_globals);
+#endif
+    
     // done
     return BOOL2SUCCESS(true);
 }
@@ -152,9 +199,19 @@ int ExtensionImpl::processShutdown(int type, int module_number TSRMLS_DC)
  */
 int ExtensionImpl::processRequest(int type, int module_number TSRMLS_DC)
 {
+    // remember the tsrm_ls pointer of this thread
+    TSRMLS_CACHED_STORE();
+    
     // get the extension
     auto *extension = find(module_number TSRMLS_CC);
     
+    // objects may be recycled during the request
+    extension->_data->apply([](const std::string &prefix, ClassBase &c) {
+        
+        // open the object pool
+        c.implementation()->openPool();
+    });
+    
     // is the callback registered?
     if (extension->_onRequest) extension->_onRequest();
     
@@ -177,6 +234,42 @@ int ExtensionImpl::processIdle(int type, int module_number TSRMLS_DC)
     // is the callback registered?
     if (extension->_onIdle) extension->_onIdle();
     
+    // idle objects in the pools are no longer needed
+    extension->_data->apply([](const std::string &prefix, ClassBase &c) {
+        
+        // close the object pool
+        c.implementation()->closePool();
+    });
+    
+    // done
+    return BOOL2SUCCESS(true);
+}
+
+/**
+ *  Function that is called after the engine has cleaned up the request
+ *
+ *  Objects that are stored in arrays, in static properties or in reference
+ *  cycles are only destructed after the request shutdown functions of all
+ *  extensions were called, so memory and module globals that these objects 
+ *  may still use are released here. This function is called for every 
+ *  extension, but all extensions share the same data, which is released only
+ *  once.
+ *
+ *  @return int         0 on success
+ */
+int ExtensionImpl::processCleanup()
+{
+    // the engine does not pass the tsrm_ls pointer to this function
+    TSRMLS_CACHED_FETCH();
+    
+    // module globals that only live during the request are destroyed (the
+    // slots are emptied, so a second call does nothing)
+    ModuleGlobalsBase::release(PHPCPP_G(slots), PHPCPP_G(size), false);
+    
+    // the memory in the request arena is no longer needed (this does
+    // nothing if an other extension already released it)
+    RequestArena::release();
+    
     // done
     return BOOL2SUCCESS(true);
 }
@@ -205,12 +298,12 @@ ExtensionImpl::ExtensionImpl(Extension *data, const char *name, const char *vers
     _entry.module_shutdown_func = &ExtensionImpl::processShutdown; // shutdown function for the whole extension
     _entry.request_startup_func = &ExtensionImpl::processRequest;  // startup function per request
     _entry.request_shutdown_func = &ExtensionImpl::processIdle;    // shutdown function per request
-    _entry.info_func = NULL;                                       // information for retrieving info
+    _entry.info_func = &ExtensionImpl::processInfo;                // information for retrieving info
     _entry.version = version;                                      // version string
     _entry.globals_size = 0;                                       // size of the global variables
     _entry.globals_ctor = NULL;                                    // constructor for global variables
     _entry.globals_dtor = NULL;                                    // destructor for global variables
-    _entry.post_deactivate_func = NULL;                            // unknown function
+    _entry.post_deactivate_func = &ExtensionImpl::processCleanup;  // called after the engine has cleaned up the request
     _entry.module_started = 0;                                     // module is not yet started
     _entry.type = 0;                                               // temporary or persistent module, will be filled by Zend engine
     _entry.handle = NULL;                                          // dlopen() handle, will be filled by Zend engine
@@ -233,6 +326,9 @@ ExtensionImpl::~ExtensionImpl()
 {
     // deallocate functions
     if (_entry.functions) delete[] _entry.functions;
+    
+    // deallocate the php.ini settings
+    if (_ini_entries) delete[] _ini_entries;
 }
 
 /**
@@ -279,6 +375,144 @@ zend_module_entry *ExtensionImpl::module()
     return &_entry;
 }
 
+/**
+ *  Function that is called to print the section of the extension in the 
+ *  phpinfo() output
+ *  @param  module      The module entry
+ *  @param  tsrm_ls
+ */
+void ExtensionImpl::processInfo(zend_module_entry *module TSRMLS_DC)
+{
+    // get the extension
+    auto *extension = find(module->module_number TSRMLS_CC);
+    
+    // object to add the rows
+    Info info;
+    
+    // start the table
+    php_info_print_table_start();
+    
+    // general information
+    info.header(module->name, "enabled");
+    info.row("Version", module->version);
+    info.row("Functions", extension->_data->functions());
+    info.row("Namespaces", extension->_data->namespaces());
+    info.row("Worker threads", WorkerPool::size());
+    info.row("Instrumentation", extension->_instrument);
+    
+    // the protocols of the stream wrappers
+    for (auto &wrapper : extension->_wrappers) info.row("Stream wrapper", wrapper->protocol() + "://");
+    
+    // the number of live objects of each class
+    extension->_data->apply([&info](const std::string &ns, ClassBase &c) {
+        
+        // the implementation of the class
+        auto impl = c.implementation();
+        
+        // the number of objects
+        std::string value = std::to_string(impl->objects()) + " objects";
+        
+        // add the counters of the object pool (if it is enabled)
+        PoolStatistics statistics = impl->statistics();
+        if (statistics.capacity > 0) value += ", " + std::to_string(statistics.idle) + "/" + std::to_string(statistics.capacity) + " idle in pool, " + std::to_string(statistics.reused) + " reused";
+        
+        // add the row
+        info.row("Class " + impl->name(), value);
+    });
+    
+    // the number of calls to each function
+    if (extension->_instrument) extension->_data->apply([&info](const std::string &ns, Function &function) {
+        
+        // the full name of the function
+        std::string name = ns.empty() ? function.name() : ns + "\\" + function.name();
+        
+        // add the row
+        info.row("Calls to " + name + "()", (int64_t)function.calls());
+    });
+    
+    // the extension can add its own rows
+    if (extension->_onInfo) extension->_onInfo(info);
+    
+    // end of the table
+    php_info_print_table_end();
+    
+    // show the php.ini settings
+    if (!extension->_ini.empty()) display_ini_entries(module);
+}
+
+/**
+ *  Function that is called to destroy the "globals" of a thread
+ *  @param  globals
+ */
+void ExtensionImpl::shutdownGlobals(zend_phpcpp_globals *globals)
+{
+    // destroy all module globals
+    ModuleGlobalsBase::release(globals->slots, globals->size, true);
+    
+    // free the slots
+    free(globals->slots);
+    
+    // there are no slots anymore
+    globals->slots = nullptr;
+    globals->size = 0;
+}
+
+/**
+ *  Function that is called by the Zend engine when a php.ini setting changes
+ *  @param  entry               The setting
+ *  @param  new_value           The new value
+ *  @param  new_value_length    Size of the new value
+ *  @param  mh_arg1             Pointer to the Ini object
+ *  @param  mh_arg2             Unused
+ *  @param  mh_arg3             Unused
+ *  @param  stage               Stage in which the setting was changed
+ *  @param  tsrm_ls
+ *  @return int                 SUCCESS or FAILURE
+ */
+static ZEND_INI_MH(updateIni)
+{
+    // assign the value to the variable
+    return BOOL2SUCCESS(((const Ini *)mh_arg1)->update(new_value, new_value_length));
+}
+
+/**
+ *  Retrieve the php.ini settings in the format of the Zend engine
+ *  @param  module_number
+ *  @return zend_ini_entry[]
+ */
+zend_ini_entry *ExtensionImpl::iniEntries(int module_number)
+{
+    // check if the settings were already converted
+    if (_ini_entries) return _ini_entries;
+    
+    // allocate memory for the settings, the last entry must be all zeros
+    _ini_entries = new zend_ini_entry[_ini.size() + 1];
+    memset(_ini_entries, 0, sizeof(zend_ini_entry) * (_ini.size() + 1));
+    
+    // index being processed
+    int i = 0;
+    
+    // fill the entries (the strings remain owned by the Ini objects)
+    for (auto &ini : _ini)
+    {
+        // the entry to fill
+        zend_ini_entry *entry = &_ini_entries[i++];
+        
+        // assign the members
+        entry->module_number = module_number;
+        entry->modifiable = ini.place();
+        entry->name = (char *)ini.name().c_str();
+        entry->name_length = ini.name().size() + 1;
+        entry->on_modify = &updateIni;
+        entry->mh_arg1 = (void *)&ini;
+        entry->value = (char *)ini.value().c_str();
+        entry->value_length = ini.value().size();
+    }
+    
+    // done
+    return _ini_entries;
+}
+
 /**
  *  Initialize the extension after it was started
  *  @param  tsrm_ls
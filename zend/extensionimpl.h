@@ -28,6 +28,12 @@ protected:
      *  @var zend_module_entry
      */
     zend_module_entry _entry;
+    
+    /**
+     *  The php.ini settings in the format that is needed by the Zend engine
+     *  @var zend_ini_entry[]
+     */
+    zend_ini_entry *_ini_entries = nullptr;
         
 public:
     /**
@@ -75,6 +81,27 @@ private:
      */
     void initialize(TSRMLS_D);
 
+    /**
+     *  Retrieve the php.ini settings in the format of the Zend engine
+     *  @param  module_number
+     *  @return zend_ini_entry[]
+     */
+    zend_ini_entry *iniEntries(int module_number);
+
+    /**
+     *  Function that is called to destroy the "globals" of a thread
+     *  @param  globals
+     */
+    static void shutdownGlobals(zend_phpcpp_globals *globals);
+
+    /**
+     *  Function that is called to print the section of the extension in the 
+     *  phpinfo() output
+     *  @param  module      The module entry
+     *  @param  tsrm_ls
+     */
+    static void processInfo(zend_module_entry *module TSRMLS_DC);
+
     /**
      *  Function that is called when the extension initializes
      *  @param  type        Module type
@@ -110,6 +137,13 @@ private:
      *  @return int         0 on success
      */
     static int processIdle(int type, int module_number TSRMLS_DC);
+
+    /**
+     *  Function that is called after the engine has cleaned up the request,
+     *  when all objects of the request have been destructed
+     *  @return int         0 on success
+     */
+    static int processCleanup();
 };
 
 /**
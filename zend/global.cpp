@@ -23,7 +23,7 @@ Global &Global::update()
     if (_exists) return *this;
     
     // we need the TSRMLS variable
-    TSRMLS_FETCH();
+    TSRMLS_CACHED_FETCH();
 
     // add the variable to the globals
     zend_hash_add(EG(active_symbol_table), _name.c_str(), _name.size()+1, &_val, sizeof(zval*), NULL);
@@ -40,7 +40,7 @@ Global Globals::operator[](const char *name)
     zval **varvalue;
     
     // we need the TSRMLS variable
-    TSRMLS_FETCH();
+    TSRMLS_CACHED_FETCH();
     
     // check if the variable already exists
     if (zend_hash_find(&EG(symbol_table), name, strlen(name)+1, (void**)&varvalue) == FAILURE) 
@@ -68,7 +68,7 @@ Global Globals::operator[](const std::string &name)
     zval **varvalue;
 
     // we need the TSRMLS variable
-    TSRMLS_FETCH();
+    TSRMLS_CACHED_FETCH();
     
     // check if the variable already exists
     if (zend_hash_find(&EG(symbol_table), name.c_str(), name.size()+1, (void**)&varvalue) == FAILURE) 
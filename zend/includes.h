@@ -18,7 +18,25 @@
 #include <memory>
 #include <list>
 #include <exception>
+#include <new>
 #include <type_traits>
+#include <unordered_map>
+#include <algorithm>
+#include <cmath>
+#include <clocale>
+#include <typeinfo>
+#include <mutex>
+#include <chrono>
+#include <atomic>
+#include <thread>
+#include <future>
+#include <deque>
+#include <condition_variable>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
 
 // for debug
 #include <iostream>
@@ -34,6 +52,7 @@
 #include <php.h>
 #include <zend_exceptions.h>
 #include <zend_interfaces.h>
+#include <ext/standard/info.h>
 
 /**
  *  Macro to convert results to success status
@@ -64,14 +83,40 @@
 #include "../include/base.h"
 #include "../include/countable.h"
 #include "../include/arrayaccess.h"
+#include "../include/indexaccess.h"
+#include "../include/sortkey.h"
+#include "../include/sortable.h"
 #include "../include/serializable.h"
+#include "../include/encoder.h"
+#include "../include/decoder.h"
+#include "../include/streamserializable.h"
 #include "../include/iterator.h"
+#include "../include/chunkediterator.h"
 #include "../include/traversable.h"
 #include "../include/classtype.h"
+#include "../include/poolstatistics.h"
+#include "../include/arenastatistics.h"
+#include "../include/requestarena.h"
+#include "../include/arenaallocator.h"
+#include "../include/cachestatistics.h"
+#include "../include/cache.h"
+#include "../include/moduleglobals.h"
+#include "../include/sharedcache.h"
+#include "../include/workerpool.h"
+#include "../include/kernels.h"
+#include "../include/writer.h"
+#include "../include/stream.h"
+#include "../include/bufferstream.h"
+#include "../include/mappedfilestream.h"
+#include "../include/streamwrapper.h"
+#include "../include/inputstream.h"
+#include "../include/datamember.h"
 #include "../include/classbase.h"
 #include "../include/interface.h"
 #include "../include/class.h"
 #include "../include/namespace.h"
+#include "../include/ini.h"
+#include "../include/info.h"
 #include "../include/extension.h"
 #include "../include/call.h"
 
@@ -85,6 +130,7 @@
  *  Specific zend implementation  files for internal use only
  */
 #include "init.h"
+#include "tsrm.h"
 #include "callable.h"
 #include "function.h"
 #include "method.h"
@@ -103,7 +149,11 @@
 #include "invaliditerator.h"
 #include "traverseiterator.h"
 #include "iteratorimpl.h"
+#include "cacheimpl.h"
+#include "sharedcacheimpl.h"
+#include "streamwrapperimpl.h"
 #include "classimpl.h"
+#include "magicmethod.h"
 #include "objectimpl.h"
 #include "parametersimpl.h"
 #include "extensionimpl.h"
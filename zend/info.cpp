@@ -0,0 +1,68 @@
+/**
+ *  Info.cpp
+ *
+ *  Implementation of the Info class, that adds rows to the phpinfo() output
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 Copernica BV
+ */
+#include "includes.h"
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Add a header row
+ *  @param  name        Text in the left column
+ *  @param  value       Text in the right column
+ *  @return Info
+ */
+Info &Info::header(const std::string &name, const std::string &value)
+{
+    // pass on to the engine
+    php_info_print_table_header(2, name.c_str(), value.c_str());
+    
+    // allow chaining
+    return *this;
+}
+
+/**
+ *  Add a row
+ *  @param  name        Text in the left column
+ *  @param  value       Text in the right column
+ *  @return Info
+ */
+Info &Info::row(const std::string &name, const std::string &value)
+{
+    // pass on to the engine
+    php_info_print_table_row(2, name.c_str(), value.c_str());
+    
+    // allow chaining
+    return *this;
+}
+
+/**
+ *  Add a row with the counters of a cache
+ *  @param  name        Name of the cache
+ *  @param  statistics  The counters
+ *  @return Info
+ */
+Info &Info::row(const std::string &name, const CacheStatistics &statistics)
+{
+    // format the counters
+    char buffer[256];
+    snprintf(buffer, sizeof(buffer), "%zu entries, %zu of %zu bytes, %zu hits, %zu misses (%.1f%%), %zu evictions", 
+        statistics.entries, statistics.bytes, statistics.capacity, statistics.hits, statistics.misses, 
+        statistics.hitRate() * 100.0, statistics.evictions);
+    
+    // add the row
+    return row(name, std::string(buffer));
+}
+
+/**
+ *  End namespace
+ */
+}
+
@@ -0,0 +1,134 @@
+/**
+ *  Ini.cpp
+ *
+ *  Implementation of the Ini class
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 Copernica BV
+ */
+#include "includes.h"
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Format a floating point value without losing precision
+ *  @param  value
+ *  @return std::string
+ */
+std::string Ini::format(double value)
+{
+    // format the value
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%.17g", value);
+    return buffer;
+}
+
+/**
+ *  Helper function to check if only whitespace is left in a string
+ *  @param  value
+ *  @return bool
+ */
+static bool blank(const char *value)
+{
+    // skip the whitespace
+    while (isspace((unsigned char)*value)) value++;
+
+    // is the end reached?
+    return *value == '\0';
+}
+
+/**
+ *  Assign a new value to the variable, this is called by the Zend engine
+ *  @param  value       The new value
+ *  @param  size        Size of the value
+ *  @return bool        False if the value is invalid
+ */
+bool Ini::update(const char *value, size_t size) const
+{
+    // the value is null terminated, but we make sure it is
+    std::string copy(value ? value : "", value ? size : 0);
+    const char *data = copy.c_str();
+
+    // the variable of the current thread, or the variable that is shared by all threads
+    void *variable = _locate ? _locate() : _variable;
+
+    // pointer to the end of a number
+    char *end;
+
+    // numbers that are out of range are detected with errno
+    errno = 0;
+
+    // check the type
+    switch (_kind) {
+    case Kind::Integer: {
+        // parse the number
+        int64_t result = strtoll(data, &end, 10);
+        if (end == data || !blank(end) || errno == ERANGE) return false;
+
+        // store it
+        *(int64_t *)variable = result;
+        return true;
+    }
+    case Kind::Float: {
+        // parse the number
+        double result = strtod(data, &end);
+        if (end == data || !blank(end)) return false;
+
+        // store it
+        *(double *)variable = result;
+        return true;
+    }
+    case Kind::Bool: {
+        // these words mean true, just like they do for the settings of php itself
+        if (strcasecmp(data, "true") == 0 || strcasecmp(data, "yes") == 0 || strcasecmp(data, "on") == 0) *(bool *)variable = true;
+
+        // otherwise the value is a number
+        else *(bool *)variable = atoi(data) != 0;
+
+        // done
+        return true;
+    }
+    case Kind::String: {
+        // copy the string
+        *(std::string *)variable = std::move(copy);
+        return true;
+    }
+    case Kind::Size: {
+        // sizes can not be negative
+        if (strchr(data, '-')) return false;
+
+        // parse the number
+        uint64_t result = strtoull(data, &end, 10);
+        if (end == data || errno == ERANGE) return false;
+
+        // the number of bytes per unit
+        uint64_t unit = 1;
+
+        // check the suffix
+        switch (*end) {
+        case 'g': case 'G': unit = 1024 * 1024 * 1024; end++; break;
+        case 'm': case 'M': unit = 1024 * 1024; end++; break;
+        case 'k': case 'K': unit = 1024; end++; break;
+        }
+
+        // nothing may follow, and the size must fit in the variable
+        if (!blank(end) || result > SIZE_MAX / unit) return false;
+
+        // store it
+        *(size_t *)variable = result * unit;
+        return true;
+    }
+    }
+
+    // unreachable
+    return false;
+}
+
+/**
+ *  End namespace
+ */
+}
+
@@ -21,11 +21,13 @@ namespace Php {
  *  PHP engine allocates a certain amount of memory, and a magic pointer that 
  *  is passed and should be forwarded to every thinkable PHP function.
  * 
- *  We don't use this architecture. We have our own environment object
- *  that makes much more sense, and that we use. However, the Zend engine
- *  expects this structure and this structure to exist.
+ *  We use it to store the instances of the Php::ModuleGlobals objects. Every
+ *  Php::ModuleGlobals object has its own index in the slots array of each
+ *  thread.
  */
 ZEND_BEGIN_MODULE_GLOBALS(phpcpp)
+    void **slots;
+    size_t size;
 ZEND_END_MODULE_GLOBALS(phpcpp)
 
 /**
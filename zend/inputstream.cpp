@@ -0,0 +1,200 @@
+/**
+ *  InputStream.cpp
+ *
+ *  Implementation of the class that reads from a PHP stream
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 Copernica BV
+ */
+#include "includes.h"
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Constructor
+ *  @param  value
+ *  @param  size
+ */
+InputStream::InputStream(const Value &value, size_t size) : _buffer(size > 0 ? size : 1), _istream(this)
+{
+    // the buffer starts empty
+    setg(_buffer.data(), _buffer.data(), _buffer.data());
+
+    // the engine is needed to find or open the stream
+    TSRMLS_CACHED_FETCH();
+
+    // a string holds the name of the stream to open
+    if (value.isString())
+    {
+        // open the stream, the engine reports errors itself
+        _stream = php_stream_open_wrapper((char *)value.rawValue(), "rb", REPORT_ERRORS, NULL);
+
+        // we have to close it
+        _owner = _stream != nullptr;
+    }
+    else if (value.type() == Type::Resource)
+    {
+        // find the stream behind the resource (this warns if it is a different kind of resource)
+        zval *val = value._val;
+        php_stream_from_zval_no_verify(_stream, &val);
+
+        // keep the resource alive while we are using it
+        if (_stream) _resource = value;
+    }
+}
+
+/**
+ *  Destructor
+ */
+InputStream::~InputStream()
+{
+    // leave alone what we did not open
+    if (!_owner) return;
+
+    // the engine is needed to close the stream
+    TSRMLS_CACHED_FETCH();
+
+    // close the stream
+    php_stream_close(_stream);
+}
+
+/**
+ *  Read from the stream of the Zend engine
+ *  @param  buffer
+ *  @param  size
+ *  @return size_t
+ */
+size_t InputStream::fill(char *buffer, size_t size)
+{
+    // nothing to read from
+    if (!_stream) return 0;
+
+    // the engine is needed to read
+    TSRMLS_CACHED_FETCH();
+
+    // read straight into the buffer
+    return php_stream_read(_stream, buffer, size);
+}
+
+/**
+ *  Called when the buffer is empty, and more data is needed
+ *  @return int_type
+ */
+InputStream::int_type InputStream::underflow()
+{
+    // there could still be data in the buffer
+    if (gptr() < egptr()) return traits_type::to_int_type(*gptr());
+
+    // fill the buffer
+    size_t size = fill(_buffer.data(), _buffer.size());
+
+    // check for the end of the stream
+    if (size == 0) return traits_type::eof();
+
+    // expose the new data
+    setg(_buffer.data(), _buffer.data(), _buffer.data() + size);
+
+    // the next character
+    return traits_type::to_int_type(*gptr());
+}
+
+/**
+ *  Called to read a block of data
+ *  @param  buffer
+ *  @param  size
+ *  @return std::streamsize
+ */
+std::streamsize InputStream::xsgetn(char *buffer, std::streamsize size)
+{
+    // number of bytes that were read
+    std::streamsize result = 0;
+
+    // keep going until the caller has enough
+    while (result < size)
+    {
+        // the data that is still in the buffer
+        std::streamsize available = egptr() - gptr();
+
+        // hand out the buffered data first
+        if (available > 0)
+        {
+            // not more than was asked for
+            std::streamsize count = std::min(available, size - result);
+
+            // copy the data
+            memcpy(buffer + result, gptr(), count);
+
+            // move on
+            setg(eback(), gptr() + count, egptr());
+            result += count;
+        }
+        else if (size - result >= (std::streamsize)_buffer.size())
+        {
+            // big reads go straight into the buffer of the caller
+            size_t count = fill(buffer + result, size - result);
+
+            // check for the end of the stream
+            if (count == 0) break;
+
+            // move on
+            result += count;
+        }
+        else
+        {
+            // small reads go through our buffer
+            if (underflow() == traits_type::eof()) break;
+        }
+    }
+
+    // done
+    return result;
+}
+
+/**
+ *  Read the next line, without the delimiter
+ *  @param  line
+ *  @param  delimiter
+ *  @return bool
+ */
+bool InputStream::getline(std::string &line, char delimiter)
+{
+    // forget the previous line, but keep its memory
+    line.clear();
+
+    // keep going until the delimiter is found
+    while (true)
+    {
+        // make sure there is data, the last line does not need a delimiter
+        if (gptr() == egptr() && underflow() == traits_type::eof()) return !line.empty();
+
+        // the data that is in the buffer
+        size_t available = egptr() - gptr();
+
+        // look for the delimiter
+        auto *end = (char *)memchr(gptr(), delimiter, available);
+
+        // is the line complete?
+        if (end)
+        {
+            // add the rest of the line
+            line.append(gptr(), end - gptr());
+
+            // skip over the delimiter
+            setg(eback(), end + 1, egptr());
+            return true;
+        }
+
+        // the line continues in the next block
+        line.append(gptr(), available);
+        setg(eback(), egptr(), egptr());
+    }
+}
+
+/**
+ *  End namespace
+ */
+}
+
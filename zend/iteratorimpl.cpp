@@ -58,6 +58,16 @@ void IteratorImpl::current(zend_object_iterator *iter, zval ***data TSRMLS_DC)
     // get the actual iterator
     IteratorImpl *iterator = self(iter);
 
+    // chunked iterators hold the value in their buffer, no copy is needed
+    if (iterator->_chunked && iterator->_chunked->valid())
+    {
+        // refer to the value in the buffer
+        *data = &iterator->_chunked->value()._val;
+        
+        // done
+        return;
+    }
+
     // retrieve the value (and store it in a member so that it is not
     // destructed when the function returns)
     iterator->_current = iterator->current();
@@ -77,6 +87,25 @@ void IteratorImpl::current(zend_object_iterator *iter, zval ***data TSRMLS_DC)
  */
 void IteratorImpl::key(zend_object_iterator *iter, zval *key TSRMLS_DC)
 {
+    // get the actual iterator
+    IteratorImpl *iterator = self(iter);
+    
+    // chunked iterators have the key in their buffer
+    if (iterator->_chunked && iterator->_chunked->valid())
+    {
+        // get the chunked iterator
+        ChunkedIterator *chunked = iterator->_chunked;
+        
+        // sequential keys are just the position
+        if (chunked->sequential()) { ZVAL_LONG(key, chunked->position()); }
+        
+        // copy the key from the buffer
+        else { ZVAL_ZVAL(key, chunked->index()._val, 1, 0); }
+        
+        // done
+        return;
+    }
+
     // retrieve the key
     Value retval(self(iter)->key());
 
@@ -98,6 +127,19 @@ void IteratorImpl::key(zend_object_iterator *iter, zval *key TSRMLS_DC)
  */
 int IteratorImpl::key(zend_object_iterator *iter, char **str_key, uint *str_key_len, ulong *int_key TSRMLS_DC)
 {
+    // get the actual iterator
+    IteratorImpl *iterator = self(iter);
+    
+    // sequential keys of a chunked iterator do not have to be constructed
+    if (iterator->_chunked && iterator->_chunked->sequential() && iterator->_chunked->valid())
+    {
+        // the key is the position
+        *int_key = iterator->_chunked->position();
+        
+        // done
+        return HASH_KEY_IS_LONG;
+    }
+    
     // retrieve the key
     Value retval(self(iter)->key());
     
@@ -31,6 +31,13 @@ private:
      */
     std::unique_ptr<Iterator> _iterator;
 
+    /**
+     *  The same iterator, if it is a chunked iterator that fills a block of
+     *  elements at once, from which we can take the elements directly
+     *  @var    ChunkedIterator
+     */
+    ChunkedIterator *_chunked;
+
     /**
      *  The current() method that is called by the Zend engine wants a 
      *  pointer-to-pointer-to-a-zval. Because of this, we have to keep the 
@@ -59,6 +66,10 @@ private:
      */
     bool valid()
     {
+        // the chunked iterator does not need a virtual call
+        if (_chunked) return _chunked->valid();
+        
+        // ask the iterator
         return _iterator->valid();
     }
     
@@ -85,6 +96,10 @@ private:
      */
     void next()
     {
+        // the chunked iterator does not need a virtual call
+        if (_chunked) return _chunked->next();
+        
+        // move the iterator
         return _iterator->next();
     }
     
@@ -161,7 +176,7 @@ public:
      *  Constructor
      *  @param  iterator        The iterator that is implemented by the extension
      */
-    IteratorImpl(Iterator *iterator) : _iterator(iterator) 
+    IteratorImpl(Iterator *iterator) : _iterator(iterator), _chunked(dynamic_cast<ChunkedIterator*>(iterator))
     {
         // initialize impl object
         _impl.data = this;
@@ -0,0 +1,574 @@
+/**
+ *  Kernels.cpp
+ *
+ *  Implementation of the numeric functions. The inner loops use four
+ *  independent accumulators, so that the compiler can keep them in
+ *  separate (vector) registers, and the processor does not have to wait
+ *  for the result of the previous addition.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 Copernica BV
+ */
+#include "includes.h"
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Minimum number of elements in a part that is processed in parallel,
+ *  smaller arrays are processed on the request thread only
+ *  @var    size_t
+ */
+static const size_t partsize = 16 * 1024;
+
+/**
+ *  Maximum number of bins of a histogram
+ *  @var    int64_t
+ */
+static const int64_t maxbins = 1024 * 1024;
+
+/**
+ *  Number of parts in which a buffer is split
+ *  @param  size        Number of elements
+ *  @return size_t
+ */
+static size_t parts(size_t size)
+{
+    // number of cores
+    size_t cores = std::thread::hardware_concurrency();
+
+    // every part should be big enough to be worth a thread
+    size_t count = size / partsize;
+
+    // at least one part, and not more than there are cores
+    if (count > cores) count = cores;
+    return count > 0 ? count : 1;
+}
+
+/**
+ *  Run a function over parts of a buffer in parallel
+ *
+ *  The function is called with the begin and end index of a part. The
+ *  first part is processed by the calling thread, the others by the
+ *  worker pool.
+ *
+ *  @param  size        Number of elements
+ *  @param  function    The function to call for each part
+ *  @return std::vector The results of the parts, in order
+ */
+template <typename F>
+static auto split(size_t size, const F &function) -> std::vector<decltype(function(0, 0))>
+{
+    // the type of the result
+    typedef decltype(function(0, 0)) Result;
+
+    // number of parts
+    size_t count = parts(size);
+
+    // the results
+    std::vector<Result> results;
+    results.reserve(count);
+
+    // small buffers are processed right away
+    if (count == 1) { results.push_back(function(0, size)); return results; }
+
+    // start the other parts in the background
+    std::vector<std::future<Result>> futures;
+    for (size_t i = 1; i < count; i++)
+    {
+        // the range of this part
+        size_t begin = size * i / count, end = size * (i + 1) / count;
+
+        // submit it
+        futures.push_back(WorkerPool::submit([&function, begin, end]() { return function(begin, end); }));
+    }
+
+    // process the first part ourselves
+    results.push_back(function(0, size / count));
+
+    // join the other parts
+    for (auto &future : futures) results.push_back(future.get());
+
+    // done
+    return results;
+}
+
+/**
+ *  Sum of a range of numbers
+ *  @param  data        The numbers
+ *  @param  begin       First index
+ *  @param  end         Index after the last one
+ *  @return double
+ */
+static double sumRange(const double *data, size_t begin, size_t end)
+{
+    // four independent accumulators
+    double a = 0.0, b = 0.0, c = 0.0, d = 0.0;
+
+    // add four numbers at a time
+    size_t i = begin;
+    for (; i + 4 <= end; i += 4)
+    {
+        a += data[i];
+        b += data[i + 1];
+        c += data[i + 2];
+        d += data[i + 3];
+    }
+
+    // the remaining numbers
+    for (; i < end; i++) a += data[i];
+
+    // combine the accumulators
+    return (a + b) + (c + d);
+}
+
+/**
+ *  Lowest and highest number in a range of numbers, NaN is skipped because
+ *  every comparison with it is false
+ *  @param  data        The numbers
+ *  @param  begin       First index
+ *  @param  end         Index after the last one
+ *  @return std::pair   Infinity and minus infinity if there are only NaNs
+ */
+static std::pair<double,double> boundsRange(const double *data, size_t begin, size_t end)
+{
+    // four independent accumulators for both bounds
+    double l0 = INFINITY, l1 = l0, l2 = l0, l3 = l0;
+    double h0 = -INFINITY, h1 = h0, h2 = h0, h3 = h0;
+
+    // process four numbers at a time
+    size_t i = begin;
+    for (; i + 4 <= end; i += 4)
+    {
+        l0 = data[i]     < l0 ? data[i]     : l0;  h0 = data[i]     > h0 ? data[i]     : h0;
+        l1 = data[i + 1] < l1 ? data[i + 1] : l1;  h1 = data[i + 1] > h1 ? data[i + 1] : h1;
+        l2 = data[i + 2] < l2 ? data[i + 2] : l2;  h2 = data[i + 2] > h2 ? data[i + 2] : h2;
+        l3 = data[i + 3] < l3 ? data[i + 3] : l3;  h3 = data[i + 3] > h3 ? data[i + 3] : h3;
+    }
+
+    // the remaining numbers
+    for (; i < end; i++)
+    {
+        l0 = data[i] < l0 ? data[i] : l0;
+        h0 = data[i] > h0 ? data[i] : h0;
+    }
+
+    // combine the accumulators
+    return std::make_pair(std::min(std::min(l0, l1), std::min(l2, l3)), std::max(std::max(h0, h1), std::max(h2, h3)));
+}
+
+/**
+ *  Lowest and highest number in a buffer, ignoring NaN
+ *  @param  buffer      The numbers (may not be empty)
+ *  @return std::pair   Both NaN if all numbers are NaN
+ */
+static std::pair<double,double> bounds(const std::vector<double> &buffer)
+{
+    // the data
+    const double *data = buffer.data();
+
+    // find the bounds of all parts
+    auto results = split(buffer.size(), [data](size_t begin, size_t end) { return boundsRange(data, begin, end); });
+
+    // combine them
+    auto result = results[0];
+    for (auto &part : results)
+    {
+        result.first = std::min(result.first, part.first);
+        result.second = std::max(result.second, part.second);
+    }
+
+    // there were only NaNs
+    if (result.first > result.second) return std::make_pair(NAN, NAN);
+
+    // done
+    return result;
+}
+
+/**
+ *  Sum of all numbers in a buffer
+ *  @param  buffer      The numbers
+ *  @return double
+ */
+static double total(const std::vector<double> &buffer)
+{
+    // the data
+    const double *data = buffer.data();
+
+    // sum the parts
+    auto results = split(buffer.size(), [data](size_t begin, size_t end) { return sumRange(data, begin, end); });
+
+    // combine them
+    double result = 0.0;
+    for (auto part : results) result += part;
+    return result;
+}
+
+/**
+ *  Retrieve a parameter
+ *  @param  params      All parameters
+ *  @param  index       Index of the parameter
+ *  @return Value
+ */
+static const Value &parameter(Parameters &params, size_t index)
+{
+    // check if the parameter was passed
+    if (index >= params.size()) throw Exception("Not enough parameters");
+
+    // done
+    return params[index];
+}
+
+/**
+ *  Copy the numbers from a PHP array into a buffer
+ *  @param  array       The array
+ *  @return std::vector
+ */
+std::vector<double> Kernels::buffer(const Value &array)
+{
+    // only arrays have numbers
+    if (!array.isArray()) throw Exception("Parameter must be an array");
+
+    // the hash table of the array
+    HashTable *table = Z_ARRVAL_P(array._val);
+
+    // allocate the buffer at once
+    std::vector<double> result;
+    result.reserve(zend_hash_num_elements(table));
+
+    // position in the array
+    HashPosition position;
+    zval **value;
+
+    // loop through the elements
+    for (zend_hash_internal_pointer_reset_ex(table, &position); zend_hash_get_current_data_ex(table, (void **)&value, &position) == SUCCESS; zend_hash_move_forward_ex(table, &position))
+    {
+        // numbers can be copied right away, other types are converted
+        switch (Z_TYPE_PP(value)) {
+        case IS_LONG:   result.push_back((double)Z_LVAL_PP(value)); break;
+        case IS_DOUBLE: result.push_back(Z_DVAL_PP(value)); break;
+        default:        result.push_back(Value(*value).floatValue()); break;
+        }
+    }
+
+    // done
+    return result;
+}
+
+/**
+ *  Turn a buffer into a PHP array
+ *  @param  buffer      The numbers
+ *  @return Value
+ */
+Value Kernels::array(const std::vector<double> &buffer)
+{
+    // construct the array at once with the right size
+    zval *result;
+    MAKE_STD_ZVAL(result);
+    array_init_size(result, buffer.size());
+
+    // add the numbers
+    for (auto number : buffer) add_next_index_double(result, number);
+
+    // wrap the array in a value (this adds a reference, so we can give up ours)
+    Value value(result);
+    zval_ptr_dtor(&result);
+
+    // done
+    return value;
+}
+
+/**
+ *  Sum of the elements of an array
+ *  @param  params      The array
+ *  @return Value       Float
+ */
+Value Kernels::sum(Parameters &params)
+{
+    // sum all numbers
+    return total(buffer(parameter(params, 0)));
+}
+
+/**
+ *  Average of the elements of an array
+ *  @param  params      The array
+ *  @return Value       Float, or null for an empty array
+ */
+Value Kernels::mean(Parameters &params)
+{
+    // copy out the numbers
+    auto numbers = buffer(parameter(params, 0));
+
+    // an empty array has no average
+    if (numbers.empty()) return nullptr;
+
+    // divide the sum by the number of elements
+    return total(numbers) / numbers.size();
+}
+
+/**
+ *  Lowest element of an array
+ *  @param  params      The array
+ *  @return Value       Float, or null for an empty array (NaN is ignored)
+ */
+Value Kernels::min(Parameters &params)
+{
+    // copy out the numbers
+    auto numbers = buffer(parameter(params, 0));
+
+    // an empty array has no lowest element
+    if (numbers.empty()) return nullptr;
+
+    // find the bounds
+    return bounds(numbers).first;
+}
+
+/**
+ *  Highest element of an array
+ *  @param  params      The array
+ *  @return Value       Float, or null for an empty array (NaN is ignored)
+ */
+Value Kernels::max(Parameters &params)
+{
+    // copy out the numbers
+    auto numbers = buffer(parameter(params, 0));
+
+    // an empty array has no highest element
+    if (numbers.empty()) return nullptr;
+
+    // find the bounds
+    return bounds(numbers).second;
+}
+
+/**
+ *  Dot product of two arrays of the same size
+ *  @param  params      The two arrays
+ *  @return Value       Float
+ */
+Value Kernels::dot(Parameters &params)
+{
+    // copy out the numbers
+    auto left = buffer(parameter(params, 0));
+    auto right = buffer(parameter(params, 1));
+
+    // the arrays must have the same size
+    if (left.size() != right.size()) throw Exception("Arrays must have the same size");
+
+    // the data
+    const double *x = left.data();
+    const double *y = right.data();
+
+    // multiply the parts
+    auto results = split(left.size(), [x, y](size_t begin, size_t end) {
+
+        // four independent accumulators
+        double a = 0.0, b = 0.0, c = 0.0, d = 0.0;
+
+        // process four numbers at a time
+        size_t i = begin;
+        for (; i + 4 <= end; i += 4)
+        {
+            a += x[i] * y[i];
+            b += x[i + 1] * y[i + 1];
+            c += x[i + 2] * y[i + 2];
+            d += x[i + 3] * y[i + 3];
+        }
+
+        // the remaining numbers
+        for (; i < end; i++) a += x[i] * y[i];
+
+        // combine the accumulators
+        return (a + b) + (c + d);
+    });
+
+    // combine the parts
+    double result = 0.0;
+    for (auto part : results) result += part;
+    return result;
+}
+
+/**
+ *  Running totals of the elements of an array
+ *  @param  params      The array
+ *  @return Value       Array of floats
+ */
+Value Kernels::prefixSum(Parameters &params)
+{
+    // copy out the numbers, the totals are calculated in place
+    auto numbers = buffer(parameter(params, 0));
+    double *data = numbers.data();
+
+    // first calculate the sum of each part
+    auto sums = split(numbers.size(), [data](size_t begin, size_t end) { return sumRange(data, begin, end); });
+
+    // the offset of each part is the sum of all parts before it
+    std::vector<double> offsets(sums.size(), 0.0);
+    for (size_t i = 1; i < sums.size(); i++) offsets[i] = offsets[i - 1] + sums[i - 1];
+
+    // the first index of each part
+    size_t size = numbers.size(), count = sums.size();
+    std::vector<size_t> boundaries;
+    for (size_t i = 0; i < count; i++) boundaries.push_back(size * i / count);
+
+    // now calculate the running totals of the parts, starting at their offset
+    split(size, [data, &offsets, &boundaries](size_t begin, size_t end) {
+
+        // the part that starts here
+        size_t part = std::lower_bound(boundaries.begin(), boundaries.end(), begin) - boundaries.begin();
+
+        // the running total
+        double total = offsets[part];
+
+        // calculate the totals
+        for (size_t i = begin; i < end; i++) data[i] = total += data[i];
+
+        // the split function needs a result
+        return true;
+    });
+
+    // turn it into an array
+    return array(numbers);
+}
+
+/**
+ *  Count the elements of an array in bins of equal width
+ *  @param  params      The array, number of bins, optional lower and upper bound
+ *  @return Value       Array with the number of elements in each bin
+ */
+Value Kernels::histogram(Parameters &params)
+{
+    // copy out the numbers
+    auto numbers = buffer(parameter(params, 0));
+
+    // number of bins
+    int64_t bins = parameter(params, 1).numericValue();
+    if (bins <= 0) throw Exception("Number of bins must be positive");
+    if (bins > maxbins) throw Exception("Number of bins is too big");
+
+    // the counters
+    std::vector<int64_t> result(bins, 0);
+
+    // nothing to count
+    if (numbers.empty()) return result;
+
+    // the range of the bins, by default that is from the lowest to the highest number
+    bool given = params.size() >= 4;
+    auto range = given ? std::make_pair(params[2].floatValue(), params[3].floatValue()) : bounds(numbers);
+    double lower = range.first, upper = range.second;
+
+    // when all numbers are NaN there is nothing to count
+    if (!given && lower != lower) return result;
+
+    // the range and its width must be finite, otherwise the bins can not be computed
+    if (!std::isfinite(lower) || !std::isfinite(upper)) throw Exception("Range of the histogram must be finite");
+    if (upper < lower) throw Exception("Upper bound must not be below lower bound");
+    if (!std::isfinite(upper - lower)) throw Exception("Range of the histogram is too big");
+
+    // factor to turn a number into a bin
+    double scale = upper > lower ? bins / (upper - lower) : 0.0;
+    if (!std::isfinite(scale)) throw Exception("Range of the histogram is too small");
+
+    // the data
+    const double *data = numbers.data();
+
+    // function to count the numbers in a part
+    auto count = [data, bins, lower, upper, scale](size_t begin, size_t end) {
+
+        // the counters of this part
+        std::vector<int64_t> counters(bins, 0);
+
+        // count the numbers
+        for (size_t i = begin; i < end; i++)
+        {
+            // skip numbers outside the range (this also skips NaN)
+            if (!(data[i] >= lower && data[i] <= upper)) continue;
+
+            // find the bin, the upper bound belongs to the last one (the bin is
+            // clamped before it is converted, so that the conversion can not overflow)
+            double bin = (data[i] - lower) * scale;
+            counters[bin < bins ? (int64_t)bin : bins - 1]++;
+        }
+
+        // done
+        return counters;
+    };
+
+    // every part has its own counters, which only pays off if the parts have 
+    // more numbers than there are bins
+    size_t size = numbers.size();
+    auto results = (size_t)bins * parts(size) <= size ? split(size, count) : std::vector<std::vector<int64_t>>(1, count(0, size));
+
+    // combine the parts
+    for (auto &counters : results)
+    {
+        for (int64_t i = 0; i < bins; i++) result[i] += counters[i];
+    }
+
+    // done
+    return result;
+}
+
+/**
+ *  Sort the elements of an array
+ *  @param  params      The array
+ *  @return Value       New array with the sorted floats, NaN at the end
+ */
+Value Kernels::sort(Parameters &params)
+{
+    // copy out the numbers
+    auto numbers = buffer(parameter(params, 0));
+    double *data = numbers.data();
+
+    // NaN is not ordered, so std::sort can not handle it, it is moved to the end
+    double *nans = std::partition(data, data + numbers.size(), [](double number) { return !std::isnan(number); });
+
+    // the size and number of parts of the numbers that are sorted
+    size_t size = nans - data, count = parts(size);
+
+    // the boundaries of the parts
+    std::vector<size_t> boundaries;
+    for (size_t i = 0; i <= count; i++) boundaries.push_back(size * i / count);
+
+    // sort the parts
+    split(size, [data](size_t begin, size_t end) {
+
+        // sort the part
+        std::sort(data + begin, data + end);
+
+        // the split function needs a result
+        return true;
+    });
+
+    // merge neighbouring parts, until there is only one part left
+    for (size_t width = 1; width < count; width *= 2)
+    {
+        // the merges of this round
+        std::vector<std::future<void>> merges;
+
+        // merge each pair of parts
+        for (size_t i = 0; i + width < count; i += 2 * width)
+        {
+            // the begin, middle and end of the pair
+            size_t begin = boundaries[i], middle = boundaries[i + width], end = boundaries[std::min(i + 2 * width, count)];
+
+            // merge in the background
+            merges.push_back(WorkerPool::submit([data, begin, middle, end]() {
+                std::inplace_merge(data + begin, data + middle, data + end);
+            }));
+        }
+
+        // wait for the round to complete
+        for (auto &merge : merges) merge.get();
+    }
+
+    // turn it into an array
+    return array(numbers);
+}
+
+/**
+ *  End namespace
+ */
+}
+
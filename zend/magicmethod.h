@@ -0,0 +1,86 @@
+/**
+ *  MagicMethod.h
+ *
+ *  Internal class for methods that have a fixed name, but that are implemented
+ *  by the __call() or __callStatic() method of the C++ class. Because the
+ *  name is registered as a real method, the Zend engine does not have to
+ *  go through the slow dynamic method lookup to call it.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Class definition
+ */
+class MagicMethod : public Method
+{
+public:
+    /**
+     *  Constructor
+     *
+     *  @param  name            Method name
+     *  @param  impl            The class to which the method belongs
+     *  @param  flags           Access flags (Php::Static for __callStatic() methods)
+     */
+    MagicMethod(const char *name, ClassImpl *impl, int flags) : Method(name, flags, {}), _impl(impl), _static(flags & Static) {}
+
+    /**
+     *  Destructor
+     */
+    virtual ~MagicMethod() {}
+
+    /**
+     *  Invoke the method
+     *  @param  parameters
+     *  @return Value
+     */
+    virtual Value invoke(Parameters &parameters) override
+    {
+        // the name of the method
+        const char *name = _ptr;
+
+        // the meta information about the class
+        ClassBase *meta = _impl->base();
+
+        // the function could throw an exception
+        try
+        {
+            // is this a static, or a non-static call?
+            if (_static) return meta->callCallStatic(name, parameters);
+            else return meta->callCall(parameters.object(), name, parameters);
+        }
+        catch (const NotImplemented &exception)
+        {
+            // the magic method was not implemented, report the error ourselves
+            zend_error(E_ERROR, "Undefined method %s", name);
+
+            // unreachable
+            return nullptr;
+        }
+    }
+
+private:
+    /**
+     *  The class to which the method belongs
+     *  @var    ClassImpl
+     */
+    ClassImpl *_impl;
+
+    /**
+     *  Is this a static method (forwarded to __callStatic())?
+     *  @var    bool
+     */
+    bool _static;
+};
+
+/**
+ *  End of namespace
+ */
+}
+
@@ -0,0 +1,92 @@
+/**
+ *  MappedFileStream.cpp
+ *
+ *  Implementation of the stream over a memory mapped file
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 Copernica BV
+ */
+#include "includes.h"
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Constructor
+ *  @param  path
+ */
+MappedFileStream::MappedFileStream(const char *path)
+{
+    // open the file
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) return;
+
+    // find out the size
+    struct stat info;
+    if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) { ::close(fd); return; }
+
+    // remember the properties
+    _size = info.st_size;
+    _mtime = info.st_mtime;
+
+    // an empty file can not be mapped, but it is a valid stream
+    if (_size > 0)
+    {
+        // map the file
+        void *mapping = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        // the descriptor is no longer needed, the mapping keeps the file open
+        ::close(fd);
+
+        // check for failure
+        if (mapping == MAP_FAILED) return;
+
+        // the data is normally read from start to end
+        madvise(mapping, _size, MADV_SEQUENTIAL);
+
+        // expose the mapping
+        _mapping = mapping;
+        assign((const char *)mapping, _size);
+    }
+    else
+    {
+        // nothing to map
+        ::close(fd);
+    }
+
+    // the file is opened
+    _valid = true;
+}
+
+/**
+ *  Destructor
+ */
+MappedFileStream::~MappedFileStream()
+{
+    // unmap the file
+    if (_mapping) munmap(_mapping, _size);
+}
+
+/**
+ *  Retrieve information about the file
+ *  @param  stat
+ *  @return bool
+ */
+bool MappedFileStream::stat(StreamStat &stat)
+{
+    // the file could not be opened
+    if (!_valid) return false;
+
+    // the properties from the time the file was opened
+    stat.size = _size;
+    stat.mtime = _mtime;
+    return true;
+}
+
+/**
+ *  End namespace
+ */
+}
+
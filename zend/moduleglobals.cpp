@@ -0,0 +1,120 @@
+/**
+ *  ModuleGlobals.cpp
+ *
+ *  Implementation of the ModuleGlobalsBase class
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 Copernica BV
+ */
+#include "includes.h"
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  All module globals objects, the position in this list is the index of
+ *  the slot of the object
+ *  @return std::vector
+ */
+static std::vector<ModuleGlobalsBase*> &registry()
+{
+    // the objects
+    static std::vector<ModuleGlobalsBase*> objects;
+    
+    // done
+    return objects;
+}
+
+/**
+ *  Constructor
+ *  @param  lifetime    How long the instances live
+ */
+ModuleGlobalsBase::ModuleGlobalsBase(Lifetime lifetime) : _index(registry().size()), _lifetime(lifetime)
+{
+    // register the object
+    registry().push_back(this);
+}
+
+/**
+ *  Destructor
+ */
+ModuleGlobalsBase::~ModuleGlobalsBase()
+{
+    // the object can no longer be used to destroy instances
+    registry()[_index] = nullptr;
+}
+
+/**
+ *  Retrieve the instance of the current thread, it is created if it does
+ *  not yet exist
+ *  @return void*
+ */
+void *ModuleGlobalsBase::pointer()
+{
+    // we need the tsrm_ls variable
+    TSRMLS_CACHED_FETCH();
+    
+    // the slots of the current thread
+    void **slots = PHPCPP_G(slots);
+    
+    // is there already an instance?
+    if (_index < PHPCPP_G(size) && slots[_index]) return slots[_index];
+    
+    // do we need more slots?
+    if (_index >= PHPCPP_G(size))
+    {
+        // make room for all objects
+        size_t size = registry().size();
+        slots = (void **)realloc(slots, size * sizeof(void *));
+        
+        // the new slots are empty
+        memset(slots + PHPCPP_G(size), 0, (size - PHPCPP_G(size)) * sizeof(void *));
+        
+        // store the slots
+        PHPCPP_G(slots) = slots;
+        PHPCPP_G(size) = size;
+    }
+    
+    // create the instance
+    return slots[_index] = construct();
+}
+
+/**
+ *  Destroy the instances in the slots of a thread
+ *  @param  slots       The slots
+ *  @param  size        Number of slots
+ *  @param  all         Also destroy the instances that live as long as the thread?
+ */
+void ModuleGlobalsBase::release(void **slots, size_t size, bool all)
+{
+    // the objects that created the instances
+    auto &objects = registry();
+    
+    // loop through the slots
+    for (size_t i = 0; i < size; i++)
+    {
+        // skip empty slots
+        if (!slots[i]) continue;
+        
+        // the object that created the instance (it is gone when the extension is unloaded)
+        ModuleGlobalsBase *object = objects[i];
+        
+        // instances that live as long as the thread are only destroyed at the end
+        if (!all && object && object->_lifetime == Lifetime::Thread) continue;
+        
+        // empty the slot first, the destructor might access the globals
+        void *instance = slots[i];
+        slots[i] = nullptr;
+        
+        // destroy the instance
+        if (object) object->destruct(instance);
+    }
+}
+
+/**
+ *  End namespace
+ */
+}
+
@@ -28,7 +28,7 @@ Object::Object(const char *name, Base *base)
     else
     {
         // we need the tsrm_ls variable
-        TSRMLS_FETCH();
+        TSRMLS_CACHED_FETCH();
         
         // this is a brand new object that should be allocated, the C++ instance
         // is already there (created by the extension) but it is not yet stored
@@ -52,7 +52,7 @@ Object::Object(const char *name, Base *base)
 void Object::instantiate(const char *name)
 {
     // we need the tsrm_ls variable
-    TSRMLS_FETCH();
+    TSRMLS_CACHED_FETCH();
 
     // convert the name into a class_entry
     auto *entry = zend_fetch_class(name, strlen(name), 0 TSRMLS_CC);
@@ -48,49 +48,71 @@ private:
      */
     Base *_object;
 
+    /**
+     *  The meta information about the class of the object
+     *  @var    ClassImpl
+     */
+    ClassImpl *_meta;
+
     /**
      *  The object handle in the Zend engine
      *  @var int
      */
     int _handle;
 
-public:
     /**
-     *  Constructor
-     *
-     *  This will create a new object in the Zend engine.
-     *
+     *  Register the zend object in the engine
+     * 
+     *  This initializes the zend object, its properties, and stores it in 
+     *  the object store. When a source object is passed, the declared
+     *  properties are shared with the source object instead of being
+     *  initialized with their default values
+     * 
      *  @param  entry       Zend class entry
-     *  @param  base        C++ object that already exists
+     *  @param  source      Optional object that is being cloned
      *  @param  tsrm_ls     Optional threading data
      */
-    ObjectImpl(zend_class_entry *entry, Base *base TSRMLS_DC)
+    void initialize(zend_class_entry *entry, const zend_object *source TSRMLS_DC)
     {
-        // allocate a mixed object (for some reason this does not have to deallocated)
-        _mixed = (MixedObject *)emalloc(sizeof(MixedObject));
-        
         // copy properties to the mixed object
         _mixed->php.ce = entry;
-        _mixed->self = this;
-        
-        // store the c++ object
-        _object = base;
-        
-        // initialize the object
-        zend_object_std_init(&_mixed->php, entry TSRMLS_CC);
         
 #if PHP_VERSION_ID < 50399
 
-        // tmp variable
-        zval *tmp;
+        // php 5.3 allocates a properties table in zend_object_std_init(), for
+        // classes without declared properties we postpone that until the 
+        // table is really needed (see materialize())
+        if (zend_hash_num_elements(&entry->default_properties) == 0)
+        {
+            // no properties and no guards yet
+            _mixed->php.properties = nullptr;
+            _mixed->php.guards = nullptr;
+        }
+        else
+        {
+            // initialize the object
+            zend_object_std_init(&_mixed->php, entry TSRMLS_CC);
+
+            // tmp variable
+            zval *tmp;
     
-        // initialize the properties, php 5.3 way
-        zend_hash_copy(_mixed->php.properties, &entry->default_properties, (copy_ctor_func_t) zval_property_ctor, &tmp, sizeof(zval*));
+            // initialize the properties, php 5.3 way
+            zend_hash_copy(_mixed->php.properties, &entry->default_properties, (copy_ctor_func_t) zval_property_ctor, &tmp, sizeof(zval*));
+        }
 
 #else
 
-        // version higher than 5.3 have an easier way to initialize
-        object_properties_init(&_mixed->php, entry);
+        // initialize the object (this does not allocate a properties table)
+        zend_object_std_init(&_mixed->php, entry TSRMLS_CC);
+        
+        // when cloning an object that has no dynamic properties, we share the
+        // values of the declared properties with the original object (the zvals
+        // are only separated when one of the objects modifies them)
+        if (source && source->properties_table && !source->properties) share(source);
+        
+        // version higher than 5.3 have an easier way to initialize, and
+        // there is nothing to initialize if no properties were declared
+        else if (entry->default_properties_count) object_properties_init(&_mixed->php, entry);
 
 #endif    
 
@@ -117,6 +139,90 @@ public:
         // seem to be necessary...
         _handle = zend_objects_store_put(php(), (zend_objects_store_dtor_t)destructMethod, (zend_objects_free_object_storage_t)freeMethod, NULL TSRMLS_CC);
         
+        // one more live object
+        if (_meta) _meta->track(1);
+    }
+
+#if PHP_VERSION_ID >= 50400
+    /**
+     *  Share the declared properties with an other object
+     *  @param  source      The object to share with
+     */
+    void share(const zend_object *source)
+    {
+        // number of declared properties
+        int count = source->ce->default_properties_count;
+        
+        // allocate the table in one go
+        _mixed->php.properties_table = (zval **)emalloc(sizeof(zval *) * count);
+        
+        // copy the pointers, and increment the refcounts
+        for (int i = 0; i < count; i++)
+        {
+            // the value (properties that were unset are null pointers)
+            zval *value = source->properties_table[i];
+            
+            // share the value
+            if (value) Z_ADDREF_P(value);
+            _mixed->php.properties_table[i] = value;
+        }
+    }
+#endif
+
+public:
+    /**
+     *  Constructor
+     *
+     *  This will create a new object in the Zend engine.
+     *
+     *  @param  entry       Zend class entry
+     *  @param  base        C++ object that already exists
+     *  @param  tsrm_ls     Optional threading data
+     */
+    ObjectImpl(zend_class_entry *entry, Base *base TSRMLS_DC) : ObjectImpl(entry, base, ClassImpl::find(entry), nullptr TSRMLS_CC) {}
+
+    /**
+     *  Constructor for when the class is already known
+     *
+     *  @param  entry       Zend class entry
+     *  @param  base        C++ object that already exists
+     *  @param  meta        The class to which the object belongs
+     *  @param  tsrm_ls     Optional threading data
+     */
+    ObjectImpl(zend_class_entry *entry, Base *base, ClassImpl *meta TSRMLS_DC) : ObjectImpl(entry, base, meta, nullptr TSRMLS_CC) {}
+
+    /**
+     *  Constructor for a clone
+     *
+     *  This will create a new object in the Zend engine, that gets the same
+     *  declared properties as the source object (if the source object has
+     *  no dynamic properties, otherwise the properties are initialized with
+     *  their defaults and should be copied with zend_objects_clone_members())
+     *
+     *  @param  entry       Zend class entry
+     *  @param  base        C++ object that already exists
+     *  @param  meta        The class to which the object belongs
+     *  @param  source      The object that is cloned
+     *  @param  tsrm_ls     Optional threading data
+     */
+    ObjectImpl(zend_class_entry *entry, Base *base, ClassImpl *meta, ObjectImpl *source TSRMLS_DC)
+    {
+        // allocate a mixed object (for some reason this does not have to deallocated)
+        _mixed = (MixedObject *)emalloc(sizeof(MixedObject));
+        
+        // we are the implementation of the mixed object
+        _mixed->self = this;
+        
+        // store the c++ object
+        _object = base;
+        
+        // and the class to which it belongs (this is stored, so that the
+        // handlers do not have to go through the class entry)
+        _meta = meta;
+        
+        // register the object in the engine
+        initialize(entry, source ? source->php() : nullptr TSRMLS_CC);
+        
         // the object may remember that we are its implementation object
         base->_impl = this;
     }
@@ -142,6 +248,44 @@ public:
         // destruct the object
         delete this;
     }
+
+    /**
+     *  Release the object so that it can be put in the object pool
+     * 
+     *  The properties of the zend object are destructed, but the memory of
+     *  the zend object and the C++ object stay allocated, so that they can 
+     *  later be recycled
+     * 
+     *  @param  tsrm_ls
+     */
+    void release(TSRMLS_D)
+    {
+        // destruct the properties, but keep the memory
+        zend_object_std_dtor(php() TSRMLS_CC);
+    }
+    
+    /**
+     *  Recycle a released object, and store it in the engine again
+     *  @param  entry       Zend class entry
+     *  @param  tsrm_ls
+     */
+    void recycle(zend_class_entry *entry TSRMLS_DC)
+    {
+        // register the object in the engine again
+        initialize(entry, nullptr TSRMLS_CC);
+    }
+    
+    /**
+     *  Deallocate a released object that is no longer needed in the pool
+     */
+    void discard()
+    {
+        // the zend object was already destructed, we only have to free the memory
+        efree(_mixed);
+        
+        // destruct the object
+        delete this;
+    }
     
     /**
      *  Find the object based on a zval
@@ -172,6 +316,40 @@ public:
         return mixed->self;
     }
     
+    /**
+     *  Make sure that an object has a properties table
+     * 
+     *  On php 5.3, objects of classes without declared properties are created
+     *  without a properties table, this method allocates the table before the
+     *  object is passed to one of the default handlers. Newer php versions
+     *  allocate the table on demand themselves, so nothing has to be done there.
+     * 
+     */
+    void materialize()
+    {
+#if PHP_VERSION_ID < 50399
+        // is there already a table?
+        if (_mixed->php.properties) return;
+        
+        // allocate the table
+        ALLOC_HASHTABLE(_mixed->php.properties);
+        zend_hash_init(_mixed->php.properties, 0, NULL, ZVAL_PTR_DTOR, 0);
+#endif
+    }
+
+    /**
+     *  Make sure that an object has a properties table
+     *  @param  val         Zval object
+     *  @param  tsrm_ls     Optional pointer to thread info
+     */
+    static void materialize(zval *val TSRMLS_DC)
+    {
+#if PHP_VERSION_ID < 50399
+        // find the object, and make sure it has a table
+        find(val TSRMLS_CC)->materialize();
+#endif
+    }
+    
     /**
      *  Retrieve the base class of the original C++ object
      *  @return Base
@@ -181,6 +359,15 @@ public:
         return _object;
     }
     
+    /**
+     *  Retrieve the meta information about the class of the object
+     *  @return ClassImpl
+     */
+    ClassImpl *meta() const
+    {
+        return _meta;
+    }
+    
     /**
      *  Pointer to the PHP object
      *  @return zend_object
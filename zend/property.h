@@ -1,7 +1,8 @@
 /**
  *  Property.h
  *
- *  Internal class for properties that are defined with a getter and setter method
+ *  Internal class for properties that are defined with a getter and setter method,
+ *  or that are directly bound to a data member of the C++ class
  *
  *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
  *  @copyright 2014 Copernica BV
@@ -48,6 +49,85 @@ private:
      */
     int _stype = 100;
 
+    /**
+     *  The data member, for properties that are bound to a member variable
+     *  @var    std::shared_ptr<DataMember>
+     */
+    std::shared_ptr<DataMember> _member;
+
+    /**
+     *  Read an integer data member
+     *  @param  pointer     Address of the member
+     *  @return long
+     */
+    long readInteger(const void *pointer) const
+    {
+        // check the size and signedness of the member
+        switch (_member->size()) {
+        case 1: return _member->isSigned() ? (long)*(const int8_t *)pointer  : (long)*(const uint8_t *)pointer;
+        case 2: return _member->isSigned() ? (long)*(const int16_t *)pointer : (long)*(const uint16_t *)pointer;
+        case 4: return _member->isSigned() ? (long)*(const int32_t *)pointer : (long)*(const uint32_t *)pointer;
+        default:return _member->isSigned() ? (long)*(const int64_t *)pointer : (long)*(const uint64_t *)pointer;
+        }
+    }
+
+    /**
+     *  Does an unsigned integer data member hold a value above the highest PHP integer?
+     *  @param  pointer     Address of the member
+     *  @return bool
+     */
+    bool overflows(const void *pointer) const
+    {
+        // signed members and small unsigned members always fit in a long
+        if (_member->isSigned() || _member->size() < sizeof(long)) return false;
+        
+        // compare the raw unsigned value with the highest long
+        if (_member->size() == 4) return *(const uint32_t *)pointer > (unsigned long)LONG_MAX;
+        return *(const uint64_t *)pointer > (uint64_t)LONG_MAX;
+    }
+
+    /**
+     *  Write an integer data member
+     *  @param  pointer     Address of the member
+     *  @param  value       The new value
+     */
+    void writeInteger(void *pointer, long value) const
+    {
+        // check the size of the member (the sign does not matter for storing)
+        switch (_member->size()) {
+        case 1: *(int8_t *)pointer  = (int8_t)value;  break;
+        case 2: *(int16_t *)pointer = (int16_t)value; break;
+        case 4: *(int32_t *)pointer = (int32_t)value; break;
+        default:*(int64_t *)pointer = (int64_t)value; break;
+        }
+    }
+
+    /**
+     *  Read a floating point data member
+     *  @param  pointer     Address of the member
+     *  @return double
+     */
+    double readFloat(const void *pointer) const
+    {
+        // check the size of the member
+        if (_member->size() == sizeof(float)) return *(const float *)pointer;
+        if (_member->size() == sizeof(double)) return *(const double *)pointer;
+        return (double)*(const long double *)pointer;
+    }
+
+    /**
+     *  Write a floating point data member
+     *  @param  pointer     Address of the member
+     *  @param  value       The new value
+     */
+    void writeFloat(void *pointer, double value) const
+    {
+        // check the size of the member
+        if (_member->size() == sizeof(float)) *(float *)pointer = (float)value;
+        else if (_member->size() == sizeof(double)) *(double *)pointer = value;
+        else *(long double *)pointer = value;
+    }
+
 public:
     /**
      *  Constructor
@@ -114,12 +194,18 @@ public:
         _setter.s1 = setter;
     }
 
+    /**
+     *  Constructor
+     *  @param  member      The data member to which the property is bound
+     */
+    Property(const std::shared_ptr<DataMember> &member) : _gtype(2), _stype(member->readOnly() ? 100 : 2), _member(member) {}
+
     /**
      *  Copy constructor
      *  @param  that
      */
     Property(const Property &that) : 
-        _getter(that._getter), _setter(that._setter), _gtype(that._gtype), _stype(that._stype) {}
+        _getter(that._getter), _setter(that._setter), _gtype(that._gtype), _stype(that._stype), _member(that._member) {}
     
     /**
      *  Destructor
@@ -133,8 +219,11 @@ public:
      */
     Value get(Base *base)
     {
-        if (_gtype == 0) return (base->*_getter.g0)();
-        else return (base->*_getter.g1)();
+        switch (_gtype) {
+        case 0: return (base->*_getter.g0)();
+        case 1: return (base->*_getter.g1)();
+        default: return read(base);
+        }
     }
     
     /**
@@ -151,6 +240,104 @@ public:
         default: return false;
         }
     }
+
+    /**
+     *  Is the property bound to a data member?
+     *  @return bool
+     */
+    bool bound() const
+    {
+        return _gtype == 2;
+    }
+
+    /**
+     *  Read a property that is bound to a data member
+     * 
+     *  The member is converted straight into a new zval, the returned zval
+     *  has a refcount of zero, just like the values that are returned by
+     *  the other read_property handlers
+     * 
+     *  @param  base        Object to read it from
+     *  @return zval
+     */
+    zval *read(Base *base) const
+    {
+        // address of the member
+        const void *pointer = _member->pointer(base);
+        
+        // create the zval
+        zval *result;
+        MAKE_STD_ZVAL(result);
+
+        // convert the member
+        switch (_member->type()) {
+        case Type::Bool:    ZVAL_BOOL(result, *(const bool *)pointer); break;
+        case Type::Float:   ZVAL_DOUBLE(result, readFloat(pointer)); break;
+        case Type::String:  ZVAL_STRINGL(result, (char *)((const std::string *)pointer)->data(), ((const std::string *)pointer)->size(), 1); break;
+        default:
+            // unsigned values that do not fit in a long become a float, just like an integer overflow in PHP
+            if (!overflows(pointer)) ZVAL_LONG(result, readInteger(pointer));
+            else if (_member->size() == 4) ZVAL_DOUBLE(result, (double)*(const uint32_t *)pointer);
+            else ZVAL_DOUBLE(result, (double)*(const uint64_t *)pointer);
+            break;
+        }
+        
+        // the caller becomes the owner
+        Z_DELREF_P(result);
+        
+        // done
+        return result;
+    }
+    
+    /**
+     *  Write the property
+     * 
+     *  Properties that are bound to a data member are converted natively,
+     *  other properties are passed on to the setter method
+     * 
+     *  @param  base        Object to call it on
+     *  @param  value       New value
+     *  @return bool        False for read-only properties
+     */
+    bool write(Base *base, zval *value)
+    {
+        // properties with callbacks use the setter
+        if (_stype != 2) return set(base, value);
+
+        // address of the member
+        void *pointer = _member->pointer(base);
+        
+        // bools can be converted without a copy
+        if (_member->type() == Type::Bool)
+        {
+            *(bool *)pointer = zend_is_true(value);
+            return true;
+        }
+
+        // strings can be assigned right away if they already are a string
+        if (_member->type() == Type::String && Z_TYPE_P(value) == IS_STRING)
+        {
+            ((std::string *)pointer)->assign(Z_STRVAL_P(value), Z_STRLEN_P(value));
+            return true;
+        }
+
+        // other values have to be converted, which modifies the zval, so we need a copy
+        zval copy = *value;
+        zval_copy_ctor(&copy);
+        
+        // convert the copy
+        switch (_member->type()) {
+        case Type::Float:   convert_to_double(&copy); writeFloat(pointer, Z_DVAL(copy)); break;
+        case Type::String:  convert_to_string(&copy); ((std::string *)pointer)->assign(Z_STRVAL(copy), Z_STRLEN(copy)); break;
+        default:            convert_to_long(&copy); writeInteger(pointer, Z_LVAL(copy)); break;
+        }
+        
+        // forget the copy
+        zval_dtor(&copy);
+        
+        // done
+        return true;
+    }
 };    
 
 /**
@@ -0,0 +1,178 @@
+/**
+ *  RequestArena.cpp
+ *
+ *  Implementation of the request arena
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 Copernica BV
+ */
+#include "includes.h"
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Size of the blocks that are allocated from the Zend engine
+ *  @var    size_t
+ */
+static const size_t blocksize = 64 * 1024;
+
+/**
+ *  Header at the start of each block
+ */
+struct ArenaBlock
+{
+    /**
+     *  The previously allocated block
+     *  @var    ArenaBlock
+     */
+    ArenaBlock *previous;
+};
+
+/**
+ *  The state of the arena
+ */
+struct ArenaState
+{
+    /**
+     *  The most recently allocated block
+     *  @var    ArenaBlock
+     */
+    ArenaBlock *blocks = nullptr;
+
+    /**
+     *  The free space in the current block
+     *  @var    char*
+     */
+    char *current = nullptr;
+    char *end = nullptr;
+
+    /**
+     *  The counters
+     *  @var    ArenaStatistics
+     */
+    ArenaStatistics statistics;
+};
+
+/**
+ *  The arena, every thread has its own Zend memory manager, so when the
+ *  engine is thread safe, every thread also needs its own arena
+ */
+#ifdef ZTS
+static thread_local ArenaState arena;
+#else
+static ArenaState arena;
+#endif
+
+/**
+ *  Helper function to allocate a new block
+ *  @param  size        Size of the block, including the header
+ *  @return char*       Pointer to the memory after the header
+ */
+static char *reserve(size_t size)
+{
+    // allocate the block from the Zend engine (this fails if the memory limit is reached)
+    ArenaBlock *block = (ArenaBlock *)emalloc(size);
+
+    // link the block
+    block->previous = arena.blocks;
+    arena.blocks = block;
+
+    // update the counters
+    arena.statistics.reserved += size;
+    arena.statistics.blocks += 1;
+    if (arena.statistics.reserved > arena.statistics.peakReserved) arena.statistics.peakReserved = arena.statistics.reserved;
+
+    // memory after the header
+    return (char *)(block + 1);
+}
+
+/**
+ *  Allocate memory that is valid until the end of the request
+ *  @param  size        Number of bytes
+ *  @param  alignment   Required alignment, must be a power of two
+ *  @return void*
+ */
+void *RequestArena::allocate(size_t size, size_t alignment)
+{
+    // the size of a block of its own, including the header and the alignment, may not overflow
+    if (alignment > SIZE_MAX - sizeof(ArenaBlock) || size > SIZE_MAX - sizeof(ArenaBlock) - alignment) throw std::bad_alloc();
+
+    // align the current position
+    uintptr_t position = ((uintptr_t)arena.current + alignment - 1) & ~(uintptr_t)(alignment - 1);
+
+    // is there room in the current block? (compared without adding to the position, which could wrap around)
+    if (arena.current && position <= (uintptr_t)arena.end && size <= (uintptr_t)arena.end - position)
+    {
+        // move the position
+        arena.current = (char *)(position + size);
+    }
+    else if (size + alignment > blocksize / 4)
+    {
+        // large allocations get a block of their own, so that the free space 
+        // in the current block can still be used for smaller allocations
+        char *data = reserve(sizeof(ArenaBlock) + size + alignment);
+
+        // align the data
+        position = ((uintptr_t)data + alignment - 1) & ~(uintptr_t)(alignment - 1);
+    }
+    else
+    {
+        // start a new block
+        arena.current = reserve(blocksize);
+        arena.end = arena.current - sizeof(ArenaBlock) + blocksize;
+
+        // align the position in the new block
+        position = ((uintptr_t)arena.current + alignment - 1) & ~(uintptr_t)(alignment - 1);
+        arena.current = (char *)(position + size);
+    }
+
+    // update the counters
+    arena.statistics.used += size;
+    if (arena.statistics.used > arena.statistics.peakUsed) arena.statistics.peakUsed = arena.statistics.used;
+
+    // done
+    return (void *)position;
+}
+
+/**
+ *  Retrieve the counters of the arena
+ *  @return ArenaStatistics
+ */
+ArenaStatistics RequestArena::statistics()
+{
+    return arena.statistics;
+}
+
+/**
+ *  Release all memory
+ */
+void RequestArena::release()
+{
+    // free all blocks
+    while (arena.blocks)
+    {
+        // the block to free
+        ArenaBlock *block = arena.blocks;
+        arena.blocks = block->previous;
+
+        // free it
+        efree(block);
+    }
+
+    // there is no current block anymore
+    arena.current = arena.end = nullptr;
+
+    // reset the counters of this request (the peaks are kept)
+    arena.statistics.used = 0;
+    arena.statistics.reserved = 0;
+    arena.statistics.blocks = 0;
+}
+
+/**
+ *  End namespace
+ */
+}
+
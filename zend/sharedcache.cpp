@@ -0,0 +1,718 @@
+/**
+ *  SharedCache.cpp
+ *
+ *  Implementation of the SharedCache and SharedCacheImpl classes
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 Copernica BV
+ */
+#include "includes.h"
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Helper function to round up a number to a multiple of 64 (the size of a cache line)
+ *  @param  size
+ *  @return size_t
+ */
+static size_t align(size_t size)
+{
+    return (size + 63) & ~(size_t)63;
+}
+
+/**
+ *  Constructor
+ *  @param  size        Size of the mapping
+ *  @param  entries     Max number of entries
+ */
+SharedCacheImpl::SharedCacheImpl(size_t size, size_t entries)
+{
+    // the number of groups must be a power of two
+    size_t groups = 1;
+    while (groups * slots < entries) groups <<= 1;
+
+    // the location of the hash table and the data area
+    size_t table = align(sizeof(Header));
+    size_t data = align(table + groups * sizeof(Group));
+
+    // the mapping must at least be big enough for the hash table
+    if (size < data) return;
+
+    // create the mapping, it is shared with the processes that are forked later
+    void *base = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) return;
+
+    // store the mapping
+    _base = (char *)base;
+    _size = size;
+
+    // construct the header (the mapping is already filled with zeros)
+    Header *header = new (_base) Header();
+    header->groups = groups;
+    header->table = table;
+    header->data = data;
+    header->pages = (size - data) / pagesize;
+    initialize(header->mutex);
+
+    // construct the groups
+    for (size_t i = 0; i < groups; i++) initialize((new (_base + table + i * sizeof(Group)) Group())->mutex);
+}
+
+/**
+ *  Destructor
+ */
+SharedCacheImpl::~SharedCacheImpl()
+{
+    // unmap the memory (other processes still have their own mapping)
+    if (_base) munmap(_base, _size);
+}
+
+/**
+ *  Calculate the hash of a key (never zero)
+ *  @param  key
+ *  @param  size
+ *  @return uint64_t
+ */
+uint64_t SharedCacheImpl::hash(const char *key, size_t size)
+{
+    // fnv-1a hash, which gives the same result in every process
+    uint64_t result = 14695981039346656037ULL;
+    for (size_t i = 0; i < size; i++) result = (result ^ (unsigned char)key[i]) * 1099511628211ULL;
+
+    // zero is used for empty slots
+    return result ? result : 1;
+}
+
+/**
+ *  Find the size class for a number of bytes
+ *  @param  size
+ *  @return size_t      The size class, or classes if it is too big
+ */
+size_t SharedCacheImpl::sizeclass(size_t size)
+{
+    // find the smallest class that is big enough
+    for (size_t result = 0; result < classes; result++) if ((chunksize << result) >= size) return result;
+
+    // too big
+    return classes;
+}
+
+/**
+ *  Initialize a mutex that is shared by the processes, and that survives
+ *  the death of its owner
+ *  @param  mutex
+ */
+void SharedCacheImpl::initialize(pthread_mutex_t &mutex)
+{
+    // the attributes of the mutex
+    pthread_mutexattr_t attributes;
+    pthread_mutexattr_init(&attributes);
+
+    // the mutex lives in the shared mapping, and is handed over when its owner dies
+    pthread_mutexattr_setpshared(&attributes, PTHREAD_PROCESS_SHARED);
+    pthread_mutexattr_setrobust(&attributes, PTHREAD_MUTEX_ROBUST);
+
+    // create the mutex
+    pthread_mutex_init(&mutex, &attributes);
+    pthread_mutexattr_destroy(&attributes);
+}
+
+/**
+ *  Lock a mutex
+ *  @param  mutex
+ *  @return bool        True when the previous owner died while holding the lock
+ */
+bool SharedCacheImpl::lock(pthread_mutex_t &mutex)
+{
+    // in the normal case the previous owner unlocked the mutex
+    if (pthread_mutex_lock(&mutex) != EOWNERDEAD) return false;
+
+    // we now own the mutex, the caller repairs the data it protects
+    pthread_mutex_consistent(&mutex);
+    return true;
+}
+
+/**
+ *  Unlock a mutex
+ *  @param  mutex
+ */
+void SharedCacheImpl::unlock(pthread_mutex_t &mutex)
+{
+    pthread_mutex_unlock(&mutex);
+}
+
+/**
+ *  Lock a group, and repair it when the previous owner died
+ *  @param  group
+ */
+void SharedCacheImpl::lock(Group *group)
+{
+    // nothing to repair if the previous owner unlocked the group
+    if (!lock(group->mutex)) return;
+
+    // an even sequence number means that the group was not being modified
+    uint32_t sequence = group->sequence.load(std::memory_order_relaxed);
+    if ((sequence & 1) == 0) return;
+
+    // the header holds the counters
+    Header *header = this->header();
+
+    // we do not know which slot was half written, so the group is emptied (the
+    // chunks are lost, because we can not trust the offsets in the slots)
+    for (auto &slot : group->slots)
+    {
+        // skip empty slots
+        if (slot.hash == 0) continue;
+
+        // update the counters
+        header->entries.fetch_sub(1, std::memory_order_relaxed);
+        header->bytes.fetch_sub(slot.keysize + slot.valuesize, std::memory_order_relaxed);
+
+        // empty the slot
+        slot.hash = 0;
+    }
+
+    // the group is consistent again
+    group->sequence.store(sequence + 1, std::memory_order_release);
+}
+
+/**
+ *  Lock the allocator, and repair it when the previous owner died
+ */
+void SharedCacheImpl::lockAllocator()
+{
+    // the header holds the administration
+    Header *header = this->header();
+
+    // nothing to repair if the previous owner unlocked the allocator
+    if (!lock(header->mutex)) return;
+
+    // the owner could have died while taking a new page, so every size class
+    // gives up the page that it was splitting (the rest of these pages is lost)
+    for (size_t type = 0; type < classes; type++) header->current[type] = header->end[type];
+}
+
+/**
+ *  Allocate a chunk
+ *  @param  size        Number of bytes
+ *  @return uint64_t    Offset of the chunk, or zero when the memory is full
+ */
+uint64_t SharedCacheImpl::allocate(size_t size)
+{
+    // find the size class
+    size_t type = sizeclass(size);
+    if (type >= classes) return 0;
+
+    // the header holds the administration
+    Header *header = this->header();
+
+    // lock the allocator
+    lockAllocator();
+
+    // take the first free chunk
+    uint64_t result = header->free[type];
+
+    // was there a free chunk?
+    if (result) 
+    {
+        // the next free chunk is stored inside the chunk
+        header->free[type] = *(uint64_t *)(_base + result);
+    }
+    else
+    {
+        // is the current page of this class full?
+        if (header->current[type] == header->end[type])
+        {
+            // are there pages left?
+            if (header->used == header->pages)
+            {
+                // the memory is full
+                unlock(header->mutex);
+                return 0;
+            }
+
+            // take the next page
+            header->current[type] = header->data + header->used++ * pagesize;
+            header->end[type] = header->current[type] + pagesize;
+        }
+
+        // split a chunk from the page
+        result = header->current[type];
+        header->current[type] += chunksize << type;
+    }
+
+    // unlock the allocator
+    unlock(header->mutex);
+
+    // done
+    return result;
+}
+
+/**
+ *  Free a chunk
+ *  @param  offset      Offset of the chunk
+ *  @param  size        Number of bytes
+ */
+void SharedCacheImpl::free(uint64_t offset, size_t size)
+{
+    // find the size class
+    size_t type = sizeclass(size);
+
+    // the header holds the administration
+    Header *header = this->header();
+
+    // lock the allocator
+    lockAllocator();
+
+    // add the chunk to the front of the free list
+    *(uint64_t *)(_base + offset) = header->free[type];
+    header->free[type] = offset;
+
+    // unlock the allocator
+    unlock(header->mutex);
+}
+
+/**
+ *  Evict the oldest entry of a size class, from a sample of the groups
+ *  @param  type        The size class
+ *  @return bool        False if there are no entries of this class
+ */
+bool SharedCacheImpl::evict(size_t type)
+{
+    // the header holds the counters
+    Header *header = this->header();
+
+    // the group with the oldest entry that was found so far, and a copy of its slot
+    Group *victim = nullptr;
+    Slot oldest;
+
+    // every search starts at the next part of the table, so that all groups get their turn
+    uint64_t start = header->cursor.fetch_add(sample, std::memory_order_relaxed);
+
+    // search the sample, and the rest of the table if the sample has no entries of this class
+    for (uint64_t i = 0; i < header->groups && (i < sample || !victim); i++)
+    {
+        // the group to search
+        Group *group = (Group *)(_base + header->table) + ((start + i) & (header->groups - 1));
+
+        // check all slots
+        for (auto &current : group->slots)
+        {
+            // copy the slot, the group is not locked
+            Slot slot;
+            memcpy(&slot, &current, sizeof(Slot));
+
+            // it must be an older entry of the same size class
+            if (slot.hash == 0 || sizeclass(slot.keysize + slot.valuesize) != type) continue;
+            if (victim && slot.stamp >= oldest.stamp) continue;
+
+            // this is the best candidate so far
+            victim = group;
+            oldest = slot;
+        }
+    }
+
+    // there are no entries of this class that could make room
+    if (!victim) return false;
+
+    // lock the group
+    lock(victim);
+
+    // look up the slot again, it could have been changed before we got the lock
+    for (auto &slot : victim->slots)
+    {
+        // is this the slot?
+        if (slot.hash != oldest.hash || slot.offset != oldest.offset) continue;
+
+        // empty the slot
+        erase(victim, &slot);
+
+        // unlock the group
+        unlock(victim->mutex);
+
+        // update the counters
+        header->entries.fetch_sub(1, std::memory_order_relaxed);
+        header->evictions.fetch_add(1, std::memory_order_relaxed);
+        header->bytes.fetch_sub(oldest.keysize + oldest.valuesize, std::memory_order_relaxed);
+
+        // free the chunk
+        free(oldest.offset, oldest.keysize + oldest.valuesize);
+
+        // done
+        return true;
+    }
+
+    // unlock the group
+    unlock(victim->mutex);
+
+    // another process changed the slot, but the caller may try again
+    return true;
+}
+
+/**
+ *  Empty a slot (the group must be locked)
+ *  @param  group
+ *  @param  slot
+ */
+void SharedCacheImpl::erase(Group *group, Slot *slot)
+{
+    // mark the group as being modified
+    uint32_t sequence = group->sequence.load(std::memory_order_relaxed);
+    group->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    // empty the slot
+    slot->hash = 0;
+
+    // the group is consistent again
+    group->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+/**
+ *  Find a slot in a group (the group must be locked)
+ *  @param  group
+ *  @param  hash
+ *  @param  key
+ *  @param  size
+ *  @return Slot        The slot, or nullptr
+ */
+SharedCacheImpl::Slot *SharedCacheImpl::find(Group *group, uint64_t hash, const char *key, size_t size) const
+{
+    // check all slots
+    for (auto &slot : group->slots)
+    {
+        // compare the hash and the key
+        if (slot.hash != hash || slot.keysize != size) continue;
+        if (memcmp(_base + slot.offset, key, size) == 0) return &slot;
+    }
+
+    // not found
+    return nullptr;
+}
+
+/**
+ *  Store data
+ *  @param  key         The key
+ *  @param  data        The data
+ *  @param  size        Size of the data
+ *  @return bool
+ */
+bool SharedCacheImpl::store(const std::string &key, const char *data, size_t size)
+{
+    // the mapping must exist
+    if (!_base) return false;
+
+    // the header holds the counters
+    Header *header = this->header();
+
+    // the size class of the key and the data
+    size_t total = key.size() + size;
+    size_t type = sizeclass(total);
+    if (type >= classes) return false;
+
+    // allocate a chunk, when the memory is full the oldest entries of the same size make room
+    uint64_t offset = allocate(total);
+    for (size_t attempt = 0; !offset && attempt < 8 && evict(type); attempt++) offset = allocate(total);
+    if (!offset) return false;
+
+    // fill the chunk, it is not yet visible for other processes
+    memcpy(_base + offset, key.data(), key.size());
+    memcpy(_base + offset + key.size(), data, size);
+
+    // find the group
+    uint64_t hash = this->hash(key.data(), key.size());
+    Group *group = this->group(hash);
+
+    // lock the group
+    lock(group);
+
+    // find the slot with the same key
+    Slot *slot = find(group, hash, key.data(), key.size());
+    bool replace = slot != nullptr;
+
+    // otherwise we use an empty slot, or the oldest slot if the group is full
+    if (!slot) for (auto &candidate : group->slots)
+    {
+        // is this the best candidate so far?
+        if (!slot || candidate.hash == 0 || (slot->hash != 0 && candidate.stamp < slot->stamp)) slot = &candidate;
+
+        // an empty slot can not be beaten
+        if (slot->hash == 0) break;
+    }
+
+    // remember what was stored in the slot before
+    Slot old = *slot;
+
+    // mark the group as being modified
+    uint32_t sequence = group->sequence.load(std::memory_order_relaxed);
+    group->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    // fill the slot
+    slot->hash = hash;
+    slot->offset = offset;
+    slot->keysize = key.size();
+    slot->valuesize = size;
+    slot->stamp = header->stamp.fetch_add(1, std::memory_order_relaxed);
+
+    // the group is consistent again
+    group->sequence.store(sequence + 2, std::memory_order_release);
+
+    // unlock the group
+    unlock(group->mutex);
+
+    // update the counters
+    header->insertions.fetch_add(1, std::memory_order_relaxed);
+    header->bytes.fetch_add(total, std::memory_order_relaxed);
+
+    // was a different entry stored in the slot?
+    if (old.hash == 0) header->entries.fetch_add(1, std::memory_order_relaxed);
+    else if (!replace) header->evictions.fetch_add(1, std::memory_order_relaxed);
+
+    // free the old chunk
+    if (old.hash != 0)
+    {
+        header->bytes.fetch_sub(old.keysize + old.valuesize, std::memory_order_relaxed);
+        free(old.offset, old.keysize + old.valuesize);
+    }
+
+    // done
+    return true;
+}
+
+/**
+ *  Retrieve data
+ *  @param  key         The key
+ *  @param  result      String to copy the data to, or nullptr
+ *  @return bool        Was the key found?
+ */
+bool SharedCacheImpl::fetch(const std::string &key, std::string *result)
+{
+    // the mapping must exist
+    if (!_base) return false;
+
+    // the header holds the counters
+    Header *header = this->header();
+
+    // find the group
+    uint64_t hash = this->hash(key.data(), key.size());
+    Group *group = this->group(hash);
+
+    // readers do not lock, they try again when the group was modified in the meantime
+    while (true)
+    {
+        // wait until the group is not being modified, by waiting for the lock of
+        // the writer (which also repairs the group if the writer died)
+        uint32_t sequence = group->sequence.load(std::memory_order_acquire);
+        if (sequence & 1) { lock(group); unlock(group->mutex); continue; }
+
+        // was the key found?
+        bool found = false;
+
+        // check all slots
+        for (auto &current : group->slots)
+        {
+            // copy the slot, it could be modified while we are reading it
+            Slot slot;
+            memcpy(&slot, &current, sizeof(Slot));
+
+            // compare the hash and the size of the key
+            if (slot.hash != hash || slot.keysize != key.size()) continue;
+
+            // the data could be garbage when the group was modified, make sure we stay inside the mapping
+            if (slot.offset < header->data || slot.offset + slot.keysize + slot.valuesize > _size) break;
+
+            // compare the key
+            if (memcmp(_base + slot.offset, key.data(), key.size()) != 0) continue;
+
+            // copy the data
+            if (result) result->assign(_base + slot.offset + slot.keysize, slot.valuesize);
+
+            // done
+            found = true;
+            break;
+        }
+
+        // if the group was modified, we start over
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (group->sequence.load(std::memory_order_relaxed) != sequence) continue;
+
+        // update the counters
+        if (found) header->hits.fetch_add(1, std::memory_order_relaxed);
+        else header->misses.fetch_add(1, std::memory_order_relaxed);
+
+        // done
+        return found;
+    }
+}
+
+/**
+ *  Remove data
+ *  @param  key         The key
+ *  @return bool        Was the key found?
+ */
+bool SharedCacheImpl::remove(const std::string &key)
+{
+    // the mapping must exist
+    if (!_base) return false;
+
+    // the header holds the counters
+    Header *header = this->header();
+
+    // find the group
+    uint64_t hash = this->hash(key.data(), key.size());
+    Group *group = this->group(hash);
+
+    // lock the group
+    lock(group);
+
+    // find the slot
+    Slot *slot = find(group, hash, key.data(), key.size());
+    if (!slot)
+    {
+        // not found
+        unlock(group->mutex);
+        return false;
+    }
+
+    // remember the chunk
+    Slot old = *slot;
+
+    // empty the slot
+    erase(group, slot);
+
+    // unlock the group
+    unlock(group->mutex);
+
+    // update the counters
+    header->entries.fetch_sub(1, std::memory_order_relaxed);
+    header->bytes.fetch_sub(old.keysize + old.valuesize, std::memory_order_relaxed);
+
+    // free the chunk
+    free(old.offset, old.keysize + old.valuesize);
+
+    // done
+    return true;
+}
+
+/**
+ *  Retrieve the counters
+ *  @return CacheStatistics
+ */
+CacheStatistics SharedCacheImpl::statistics() const
+{
+    // the result
+    CacheStatistics result;
+
+    // the mapping must exist
+    if (!_base) return result;
+
+    // copy the counters
+    Header *header = this->header();
+    result.capacity = header->pages * pagesize;
+    result.bytes = header->bytes.load(std::memory_order_relaxed);
+    result.entries = header->entries.load(std::memory_order_relaxed);
+    result.hits = header->hits.load(std::memory_order_relaxed);
+    result.misses = header->misses.load(std::memory_order_relaxed);
+    result.insertions = header->insertions.load(std::memory_order_relaxed);
+    result.evictions = header->evictions.load(std::memory_order_relaxed);
+
+    // done
+    return result;
+}
+
+/**
+ *  Constructor
+ *  @param  size        Size of the shared memory segment in bytes
+ *  @param  entries     Max number of entries
+ */
+SharedCache::SharedCache(size_t size, size_t entries) : _impl(new SharedCacheImpl(size, entries)) {}
+
+/**
+ *  Destructor
+ */
+SharedCache::~SharedCache()
+{
+    // destruct the implementation
+    delete _impl;
+}
+
+/**
+ *  Was the shared memory segment created?
+ *  @return bool
+ */
+bool SharedCache::valid() const
+{
+    return _impl->valid();
+}
+
+/**
+ *  Store a PHP value
+ *  @param  key         The key
+ *  @param  value       Value to store
+ *  @return bool        False if the value is too big, or if there was no room
+ *                      for it and no entries of the same size to evict
+ */
+bool SharedCache::set(const std::string &key, const Value &value)
+{
+    // encode the value
+    Encoder encoder;
+    encoder.writeValue(value);
+
+    // store the encoded data
+    return _impl->store(key, encoder.data(), encoder.size());
+}
+
+/**
+ *  Retrieve a PHP value
+ *  @param  key         The key
+ *  @return Value       The value, or NULL if it was not found
+ */
+Value SharedCache::get(const std::string &key)
+{
+    // copy the encoded data out of the shared memory
+    std::string data;
+    if (!_impl->fetch(key, &data)) return nullptr;
+
+    // decode the value
+    Decoder decoder(data.data(), data.size());
+    return decoder.readValue();
+}
+
+/**
+ *  Check if an entry exists
+ *  @param  key         The key
+ *  @return bool
+ */
+bool SharedCache::exists(const std::string &key)
+{
+    return _impl->fetch(key, nullptr);
+}
+
+/**
+ *  Remove an entry
+ *  @param  key         The key
+ *  @return bool        Was the entry found?
+ */
+bool SharedCache::remove(const std::string &key)
+{
+    return _impl->remove(key);
+}
+
+/**
+ *  Retrieve the counters of the cache, these are shared by all processes
+ *  @return CacheStatistics
+ */
+CacheStatistics SharedCache::statistics() const
+{
+    return _impl->statistics();
+}
+
+/**
+ *  End namespace
+ */
+}
+
@@ -0,0 +1,346 @@
+/**
+ *  SharedCacheImpl.h
+ *
+ *  Implementation of the shared memory cache. The whole cache lives in one
+ *  anonymous shared mapping, and all data structures inside it refer to each
+ *  other with offsets relative to the start of the mapping.
+ *
+ *  The mapping starts with a header, followed by the hash table and the data
+ *  area. The hash table consists of groups of slots. A key always ends up in
+ *  the same group, and can be stored in any of its slots. Each group has a 
+ *  mutex for writers, and a sequence number that is odd while the group
+ *  is being modified. Readers copy what they need, and start over if the
+ *  sequence number has changed in the meantime.
+ *
+ *  The mutexes are robust, so that a worker process that dies while it holds
+ *  one does not block the others forever. The next process that locks the
+ *  mutex repairs the data that it protects: a group that was left in the 
+ *  middle of a modification is emptied (its chunks are lost), and the 
+ *  allocator gives up the pages that it was splitting. Readers that find an
+ *  odd sequence number wait for the mutex instead of spinning.
+ *
+ *  The data area is divided in pages, which are handed out to size classes.
+ *  Every size class splits its pages into chunks of equal size, and keeps 
+ *  the chunks that were freed in a free list. Pages are never returned, so
+ *  when there are no pages left, a size class can only get memory by evicting
+ *  its own entries: the oldest entry of the class in a sample of the groups
+ *  is removed.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Class definition
+ */
+class SharedCacheImpl
+{
+public:
+    /**
+     *  Size of the pages in the data area
+     */
+    static const size_t pagesize = 1024 * 1024;
+
+    /**
+     *  Size of the smallest chunk
+     */
+    static const size_t chunksize = 64;
+
+    /**
+     *  Number of size classes (the biggest chunk is a whole page)
+     */
+    static const size_t classes = 15;
+
+    /**
+     *  Number of slots in a group
+     */
+    static const size_t slots = 7;
+
+    /**
+     *  Number of groups that are searched for an entry to evict
+     */
+    static const size_t sample = 32;
+
+    /**
+     *  A slot in the hash table
+     */
+    struct Slot
+    {
+        /**
+         *  Hash of the key, zero for an empty slot
+         *  @var    uint64_t
+         */
+        uint64_t hash;
+
+        /**
+         *  Offset of the chunk with the key and the value
+         *  @var    uint64_t
+         */
+        uint64_t offset;
+
+        /**
+         *  Size of the key and the value
+         *  @var    uint32_t
+         */
+        uint32_t keysize;
+        uint32_t valuesize;
+
+        /**
+         *  Moment when the slot was written, the oldest slot is replaced
+         *  when the group is full
+         *  @var    uint64_t
+         */
+        uint64_t stamp;
+    };
+
+    /**
+     *  A group of slots
+     */
+    struct Group
+    {
+        /**
+         *  Sequence number, odd while the group is being modified
+         *  @var    std::atomic
+         */
+        std::atomic<uint32_t> sequence;
+
+        /**
+         *  Lock for writers
+         *  @var    pthread_mutex_t
+         */
+        pthread_mutex_t mutex;
+
+        /**
+         *  The slots
+         *  @var    Slot[]
+         */
+        Slot slots[SharedCacheImpl::slots];
+    };
+
+    /**
+     *  The header at the start of the mapping
+     */
+    struct Header
+    {
+        /**
+         *  Number of groups in the hash table
+         *  @var    uint64_t
+         */
+        uint64_t groups;
+
+        /**
+         *  Offsets of the hash table and the data area
+         *  @var    uint64_t
+         */
+        uint64_t table;
+        uint64_t data;
+
+        /**
+         *  Number of pages in the data area, and the number in use
+         *  @var    uint64_t
+         */
+        uint64_t pages;
+        uint64_t used;
+
+        /**
+         *  Lock for the allocator
+         *  @var    pthread_mutex_t
+         */
+        pthread_mutex_t mutex;
+
+        /**
+         *  Per size class: the first free chunk, and the part of the current
+         *  page that has not yet been split into chunks
+         *  @var    uint64_t[]
+         */
+        uint64_t free[SharedCacheImpl::classes];
+        uint64_t current[SharedCacheImpl::classes];
+        uint64_t end[SharedCacheImpl::classes];
+
+        /**
+         *  Counter for the stamps of the slots
+         *  @var    std::atomic
+         */
+        std::atomic<uint64_t> stamp;
+
+        /**
+         *  The group where the next search for an entry to evict starts
+         *  @var    std::atomic
+         */
+        std::atomic<uint64_t> cursor;
+
+        /**
+         *  The counters that are shared by all processes
+         *  @var    std::atomic
+         */
+        std::atomic<uint64_t> bytes;
+        std::atomic<uint64_t> entries;
+        std::atomic<uint64_t> hits;
+        std::atomic<uint64_t> misses;
+        std::atomic<uint64_t> insertions;
+        std::atomic<uint64_t> evictions;
+    };
+
+private:
+    /**
+     *  Start of the mapping
+     *  @var    char*
+     */
+    char *_base = nullptr;
+
+    /**
+     *  Size of the mapping
+     *  @var    size_t
+     */
+    size_t _size = 0;
+
+    /**
+     *  The header
+     *  @return Header
+     */
+    Header *header() const
+    {
+        return (Header *)_base;
+    }
+
+    /**
+     *  Find the group for a hash value
+     *  @param  hash
+     *  @return Group
+     */
+    Group *group(uint64_t hash) const
+    {
+        return (Group *)(_base + header()->table) + (hash & (header()->groups - 1));
+    }
+
+    /**
+     *  Calculate the hash of a key (never zero)
+     *  @param  key
+     *  @param  size
+     *  @return uint64_t
+     */
+    static uint64_t hash(const char *key, size_t size);
+
+    /**
+     *  Find the size class for a number of bytes
+     *  @param  size
+     *  @return size_t      The size class, or classes if it is too big
+     */
+    static size_t sizeclass(size_t size);
+
+    /**
+     *  Initialize a mutex that is shared by the processes, and that survives
+     *  the death of its owner
+     *  @param  mutex
+     */
+    static void initialize(pthread_mutex_t &mutex);
+
+    /**
+     *  Lock and unlock a mutex
+     *  @param  mutex
+     *  @return bool        True when the previous owner died while holding the lock
+     */
+    static bool lock(pthread_mutex_t &mutex);
+    static void unlock(pthread_mutex_t &mutex);
+
+    /**
+     *  Lock a group or the allocator, and repair it when the previous owner died
+     *  @param  group
+     */
+    void lock(Group *group);
+    void lockAllocator();
+
+    /**
+     *  Allocate and free a chunk
+     *  @param  size        Number of bytes
+     *  @return uint64_t    Offset of the chunk, or zero when the memory is full
+     */
+    uint64_t allocate(size_t size);
+    void free(uint64_t offset, size_t size);
+
+    /**
+     *  Evict the oldest entry of a size class, from a sample of the groups
+     *  @param  type        The size class
+     *  @return bool        False if there are no entries of this class
+     */
+    bool evict(size_t type);
+
+    /**
+     *  Empty a slot (the group must be locked)
+     *  @param  group
+     *  @param  slot
+     */
+    void erase(Group *group, Slot *slot);
+
+    /**
+     *  Find a slot in a group (the group must be locked)
+     *  @param  group
+     *  @param  hash
+     *  @param  key
+     *  @param  size
+     *  @return Slot        The slot, or nullptr
+     */
+    Slot *find(Group *group, uint64_t hash, const char *key, size_t size) const;
+
+public:
+    /**
+     *  Constructor
+     *  @param  size        Size of the mapping
+     *  @param  entries     Max number of entries
+     */
+    SharedCacheImpl(size_t size, size_t entries);
+
+    /**
+     *  Destructor
+     */
+    virtual ~SharedCacheImpl();
+
+    /**
+     *  Was the mapping created?
+     *  @return bool
+     */
+    bool valid() const
+    {
+        return _base != nullptr;
+    }
+
+    /**
+     *  Store data
+     *  @param  key         The key
+     *  @param  data        The data
+     *  @param  size        Size of the data
+     *  @return bool
+     */
+    bool store(const std::string &key, const char *data, size_t size);
+
+    /**
+     *  Retrieve data
+     *  @param  key         The key
+     *  @param  result      String to copy the data to, or nullptr
+     *  @return bool        Was the key found?
+     */
+    bool fetch(const std::string &key, std::string *result);
+
+    /**
+     *  Remove data
+     *  @param  key         The key
+     *  @return bool        Was the key found?
+     */
+    bool remove(const std::string &key);
+
+    /**
+     *  Retrieve the counters
+     *  @return CacheStatistics
+     */
+    CacheStatistics statistics() const;
+};
+
+/**
+ *  End namespace
+ */
+}
@@ -0,0 +1,114 @@
+/**
+ *  Sortable.cpp
+ *
+ *  Implementation of the function to sort arrays of Sortable objects
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 Copernica BV
+ */
+#include "includes.h"
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Helper class that holds an element of the array that is being sorted
+ */
+struct SortElement
+{
+    /**
+     *  The key of the object
+     *  @var    SortKey
+     */
+    SortKey key;
+    
+    /**
+     *  The element in the array
+     *  @var    zval
+     */
+    zval *value;
+};
+
+/**
+ *  Sort an array of objects that implement the Sortable interface
+ *  @param  array       The array to sort
+ *  @param  descending  Sort from high to low?
+ *  @return bool
+ */
+bool sort(Value &array, bool descending)
+{
+    // only arrays can be sorted
+    if (!array.isArray()) return false;
+    
+    // we need the tsrm_ls variable
+    TSRMLS_CACHED_FETCH();
+    
+    // the hash table of the array
+    HashTable *table = Z_ARRVAL_P(array._val);
+    
+    // the keys are fetched only once, and stored together with the elements
+    std::vector<SortElement> elements;
+    elements.reserve(zend_hash_num_elements(table));
+    
+    // position in the array
+    HashPosition position;
+    zval **value;
+    
+    // loop through the elements
+    for (zend_hash_internal_pointer_reset_ex(table, &position); zend_hash_get_current_data_ex(table, (void **)&value, &position) == SUCCESS; zend_hash_move_forward_ex(table, &position))
+    {
+        // the element must be an object
+        if (Z_TYPE_PP(value) != IS_OBJECT) return false;
+        
+        // and the object must be an instance of one of our classes
+        ClassImpl *meta = ClassImpl::find(zend_get_class_entry(*value TSRMLS_CC));
+        if (!meta) return false;
+        
+        // retrieve the C++ object
+        Base *base = ObjectImpl::find(*value TSRMLS_CC)->object();
+        if (!base) return false;
+        
+        // the class must implement the Sortable interface
+        Sortable *sortable = meta->sortable(base);
+        if (!sortable) return false;
+        
+        // store the key with the element
+        elements.push_back(SortElement{ sortable->sortKey(), *value });
+    }
+    
+    // sort the elements by comparing their keys, elements with the same
+    // key keep their original order
+    std::stable_sort(elements.begin(), elements.end(), [descending](const SortElement &a, const SortElement &b) {
+        return descending ? b.key < a.key : a.key < b.key;
+    });
+    
+    // construct a new array with the elements in the sorted order
+    zval *result;
+    MAKE_STD_ZVAL(result);
+    array_init_size(result, elements.size());
+    
+    // add the elements, the new array holds a reference too
+    for (auto &element : elements)
+    {
+        Z_ADDREF_P(element.value);
+        add_next_index_zval(result, element.value);
+    }
+    
+    // wrap the new array in a value (this adds a reference, so we can give up ours)
+    Value sorted(result);
+    zval_ptr_dtor(&result);
+    
+    // replace the array
+    array = std::move(sorted);
+    
+    // done
+    return true;
+}
+
+/**
+ *  End namespace
+ */
+}
+
@@ -14,10 +14,11 @@
 namespace Php {
 
 /**
- *  Some static buffers for writing data
+ *  Some static buffers for writing data, the regular output gets a bigger
+ *  buffer, so that big responses are sent in fewer calls to the engine
  *  @var StreamBuf
  */
-static StreamBuf bufOut         (0);
+static StreamBuf bufOut         (0, 64 * 1024);
 static StreamBuf bufError       (E_ERROR);
 static StreamBuf bufWarning     (E_WARNING);
 static StreamBuf bufNotice      (E_NOTICE);
@@ -0,0 +1,464 @@
+/**
+ *  StreamWrapper.cpp
+ *
+ *  Implementation of the StreamWrapper and StreamWrapperImpl classes
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 Copernica BV
+ */
+#include "includes.h"
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Constructor
+ *  @param  protocol
+ */
+StreamWrapper::StreamWrapper(const char *protocol) : _protocol(protocol), _impl(new StreamWrapperImpl(this)) {}
+
+/**
+ *  Destructor
+ */
+StreamWrapper::~StreamWrapper()
+{
+    // destruct the implementation
+    delete _impl;
+}
+
+/**
+ *  Constructor
+ *  @param  base
+ */
+StreamWrapperImpl::StreamWrapperImpl(StreamWrapper *base)
+{
+    // the engine record starts empty
+    memset(&_wrapper, 0, sizeof(php_stream_wrapper));
+
+    // the operations are the same for all wrappers, the abstract pointer tells them apart
+    _wrapper.wops = wrapperOps();
+    _wrapper.abstract = base;
+
+    // the urls are not remote, so allow_url_fopen does not apply
+    _wrapper.is_url = 0;
+}
+
+/**
+ *  Register the wrapper with the Zend engine
+ *  @param  protocol
+ */
+void StreamWrapperImpl::install(const char *protocol TSRMLS_DC)
+{
+    // register the wrapper (this fails if the protocol is already in use)
+    _installed = php_register_url_stream_wrapper(protocol, &_wrapper TSRMLS_CC) == SUCCESS;
+}
+
+/**
+ *  Unregister the wrapper
+ *  @param  protocol
+ */
+void StreamWrapperImpl::uninstall(const char *protocol TSRMLS_DC)
+{
+    // leave alone what we did not register
+    if (!_installed) return;
+
+    // unregister the wrapper
+    php_unregister_url_stream_wrapper(protocol TSRMLS_CC);
+
+    // the wrapper is gone
+    _installed = false;
+}
+
+/**
+ *  The operations of the wrapper
+ *  @return php_stream_wrapper_ops
+ */
+php_stream_wrapper_ops *StreamWrapperImpl::wrapperOps()
+{
+    // the operations, the ones that are not set are not supported
+    static php_stream_wrapper_ops ops = {
+        &StreamWrapperImpl::open,       // open a url
+        NULL,                           // close a stream (the stream operations do this)
+        NULL,                           // stat an opened stream (the stream operations do this)
+        &StreamWrapperImpl::urlStat,    // stat a url
+        NULL,                           // open a directory
+        "PHP-CPP",                      // name of the wrapper
+        &StreamWrapperImpl::unlink,     // remove a url
+    };
+
+    // expose the operations
+    return &ops;
+}
+
+/**
+ *  The operations of the opened streams
+ *  @return php_stream_ops
+ */
+php_stream_ops *StreamWrapperImpl::streamOps()
+{
+    // the operations
+    static php_stream_ops ops = {
+        &StreamWrapperImpl::write,      // write data
+        &StreamWrapperImpl::read,       // read data
+        &StreamWrapperImpl::close,      // close the stream
+        &StreamWrapperImpl::flush,      // flush buffered data
+        "PHP-CPP",                      // name of the stream type
+        &StreamWrapperImpl::seek,       // change the position
+        NULL,                           // cast to a file descriptor (not supported)
+        &StreamWrapperImpl::stat,       // stat the stream
+        &StreamWrapperImpl::option,     // set an option
+    };
+
+    // expose the operations
+    return &ops;
+}
+
+/**
+ *  Report an exception that was thrown by the extension
+ *  @param  exception
+ */
+void StreamWrapperImpl::warning(const std::exception &exception TSRMLS_DC)
+{
+    // the script goes on, so this is only a warning
+    php_error_docref(NULL TSRMLS_CC, E_WARNING, "%s", exception.what());
+}
+
+/**
+ *  Convert stream information to the format of the Zend engine
+ *  @param  stat
+ *  @param  ssb
+ */
+void StreamWrapperImpl::convert(const StreamStat &stat, php_stream_statbuf *ssb)
+{
+    // start with an empty record
+    memset(ssb, 0, sizeof(php_stream_statbuf));
+
+    // copy the properties
+    ssb->sb.st_size = stat.size;
+    ssb->sb.st_mtime = stat.mtime;
+    ssb->sb.st_nlink = 1;
+
+    // the type and the permissions
+    ssb->sb.st_mode = stat.directory ? S_IFDIR | 0555 : S_IFREG | 0444;
+    if (stat.writable) ssb->sb.st_mode |= 0200;
+}
+
+/**
+ *  Open a url
+ *  @param  wrapper
+ *  @param  filename
+ *  @param  mode
+ *  @param  options
+ *  @param  opened_path
+ *  @param  context
+ *  @return php_stream
+ */
+php_stream *StreamWrapperImpl::open(php_stream_wrapper *wrapper, const char *filename, const char *mode, int options, char **opened_path, php_stream_context *context STREAMS_DC TSRMLS_DC)
+{
+    // the user supplied wrapper
+    auto *base = (StreamWrapper *)wrapper->abstract;
+
+    try
+    {
+        // open the url
+        Stream *stream = base->open(filename, mode);
+
+        // the engine reports a failure
+        if (!stream) return NULL;
+
+        // wrap it in a stream of the engine, which now owns it
+        return php_stream_alloc(streamOps(), stream, 0, mode);
+    }
+    catch (const std::exception &exception)
+    {
+        // the engine adds the message to its own warning
+        php_stream_wrapper_log_error(wrapper, options TSRMLS_CC, "%s", exception.what());
+
+        // failure
+        return NULL;
+    }
+}
+
+/**
+ *  Retrieve information about a url
+ *  @param  wrapper
+ *  @param  url
+ *  @param  flags
+ *  @param  ssb
+ *  @param  context
+ *  @return int
+ */
+int StreamWrapperImpl::urlStat(php_stream_wrapper *wrapper, const char *url, int flags, php_stream_statbuf *ssb, php_stream_context *context TSRMLS_DC)
+{
+    // the user supplied wrapper
+    auto *base = (StreamWrapper *)wrapper->abstract;
+
+    try
+    {
+        // retrieve the information
+        StreamStat stat;
+        if (!base->stat(url, stat)) return -1;
+
+        // pass it to the engine
+        convert(stat, ssb);
+        return 0;
+    }
+    catch (const std::exception &exception)
+    {
+        // functions like file_exists() do not want warnings
+        if (!(flags & PHP_STREAM_URL_STAT_QUIET)) warning(exception TSRMLS_CC);
+
+        // failure
+        return -1;
+    }
+}
+
+/**
+ *  Remove the resource behind a url
+ *  @param  wrapper
+ *  @param  url
+ *  @param  options
+ *  @param  context
+ *  @return int
+ */
+int StreamWrapperImpl::unlink(php_stream_wrapper *wrapper, const char *url, int options, php_stream_context *context TSRMLS_DC)
+{
+    // the user supplied wrapper
+    auto *base = (StreamWrapper *)wrapper->abstract;
+
+    try
+    {
+        // remove the resource
+        return base->unlink(url) ? 1 : 0;
+    }
+    catch (const std::exception &exception)
+    {
+        // report the error
+        php_stream_wrapper_log_error(wrapper, options TSRMLS_CC, "%s", exception.what());
+
+        // failure
+        return 0;
+    }
+}
+
+/**
+ *  Write data to a stream
+ *  @param  stream
+ *  @param  buffer
+ *  @param  count
+ *  @return size_t
+ */
+size_t StreamWrapperImpl::write(php_stream *stream, const char *buffer, size_t count TSRMLS_DC)
+{
+    try
+    {
+        // pass on to the user supplied stream
+        return ((Stream *)stream->abstract)->write(buffer, count);
+    }
+    catch (const std::exception &exception)
+    {
+        // report the error
+        warning(exception TSRMLS_CC);
+
+        // nothing was written
+        return 0;
+    }
+}
+
+/**
+ *  Read data from a stream
+ *  @param  stream
+ *  @param  buffer
+ *  @param  count
+ *  @return size_t
+ */
+size_t StreamWrapperImpl::read(php_stream *stream, char *buffer, size_t count TSRMLS_DC)
+{
+    try
+    {
+        // pass on to the user supplied stream
+        size_t result = ((Stream *)stream->abstract)->read(buffer, count);
+
+        // the engine has to be told when the end is reached
+        if (result == 0) stream->eof = 1;
+
+        // done
+        return result;
+    }
+    catch (const std::exception &exception)
+    {
+        // report the error
+        warning(exception TSRMLS_CC);
+
+        // do not try again
+        stream->eof = 1;
+
+        // nothing was read
+        return 0;
+    }
+}
+
+/**
+ *  Close a stream
+ *  @param  stream
+ *  @param  close_handle
+ *  @return int
+ */
+int StreamWrapperImpl::close(php_stream *stream, int close_handle TSRMLS_DC)
+{
+    // the engine owns the user supplied stream
+    delete (Stream *)stream->abstract;
+
+    // forget the pointer
+    stream->abstract = NULL;
+
+    // done
+    return 0;
+}
+
+/**
+ *  Flush the data that is buffered by a stream
+ *  @param  stream
+ *  @return int
+ */
+int StreamWrapperImpl::flush(php_stream *stream TSRMLS_DC)
+{
+    try
+    {
+        // pass on to the user supplied stream
+        return ((Stream *)stream->abstract)->flush() ? 0 : -1;
+    }
+    catch (const std::exception &exception)
+    {
+        // report the error
+        warning(exception TSRMLS_CC);
+
+        // failure
+        return -1;
+    }
+}
+
+/**
+ *  Change the position of a stream
+ *  @param  stream
+ *  @param  offset
+ *  @param  whence
+ *  @param  newoffset
+ *  @return int
+ */
+int StreamWrapperImpl::seek(php_stream *stream, off_t offset, int whence, off_t *newoffset TSRMLS_DC)
+{
+    try
+    {
+        // pass on to the user supplied stream
+        int64_t result = ((Stream *)stream->abstract)->seek(offset, whence);
+
+        // was the position changed?
+        if (result < 0) return -1;
+
+        // tell the engine the new position
+        *newoffset = result;
+        return 0;
+    }
+    catch (const std::exception &exception)
+    {
+        // report the error
+        warning(exception TSRMLS_CC);
+
+        // failure
+        return -1;
+    }
+}
+
+/**
+ *  Retrieve information about a stream
+ *  @param  stream
+ *  @param  ssb
+ *  @return int
+ */
+int StreamWrapperImpl::stat(php_stream *stream, php_stream_statbuf *ssb TSRMLS_DC)
+{
+    try
+    {
+        // retrieve the information
+        StreamStat stat;
+        if (!((Stream *)stream->abstract)->stat(stat)) return -1;
+
+        // pass it to the engine
+        convert(stat, ssb);
+        return 0;
+    }
+    catch (const std::exception &exception)
+    {
+        // report the error
+        warning(exception TSRMLS_CC);
+
+        // failure
+        return -1;
+    }
+}
+
+/**
+ *  Set an option of a stream
+ *
+ *  The only option that is supported is the memory mapping interface. Engine
+ *  functions that copy a complete stream use it to get a pointer to the data,
+ *  which we can give them when the stream has its contents in memory.
+ *
+ *  @param  stream
+ *  @param  option
+ *  @param  value
+ *  @param  ptrparam
+ *  @return int
+ */
+int StreamWrapperImpl::option(php_stream *stream, int option, int value, void *ptrparam TSRMLS_DC)
+{
+    // other options are not supported
+    if (option != PHP_STREAM_OPTION_MMAP_API) return PHP_STREAM_OPTION_RETURN_NOTIMPL;
+
+    // the contents of the stream
+    size_t size = 0;
+    const char *data = ((Stream *)stream->abstract)->contents(size);
+
+    // streams that do not have their data in memory have to be read
+    if (!data) return PHP_STREAM_OPTION_RETURN_NOTIMPL;
+
+    // check what the engine wants
+    switch (value) {
+    case PHP_STREAM_MMAP_SUPPORTED:
+        // the stream can be mapped
+        return PHP_STREAM_OPTION_RETURN_OK;
+
+    case PHP_STREAM_MMAP_MAP_RANGE: {
+        // the range that the engine wants to see
+        auto *range = (php_stream_mmap_range *)ptrparam;
+
+        // the memory can not be changed
+        if (range->mode != PHP_STREAM_MAP_MODE_READONLY && range->mode != PHP_STREAM_MAP_MODE_SHARED_READONLY) return PHP_STREAM_OPTION_RETURN_ERR;
+
+        // limit the range to the contents (a length of 0 means everything)
+        if (range->offset > size) range->offset = size;
+        if (range->length == 0 || range->length > size - range->offset) range->length = size - range->offset;
+
+        // hand out the memory
+        range->mapped = (char *)data + range->offset;
+        return PHP_STREAM_OPTION_RETURN_OK;
+    }
+
+    case PHP_STREAM_MMAP_UNMAP:
+        // the memory stays with the stream
+        return PHP_STREAM_OPTION_RETURN_OK;
+
+    default:
+        // unknown request
+        return PHP_STREAM_OPTION_RETURN_ERR;
+    }
+}
+
+/**
+ *  End namespace
+ */
+}
+
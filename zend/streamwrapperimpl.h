@@ -0,0 +1,131 @@
+/**
+ *  StreamWrapperImpl.h
+ *
+ *  Implementation of a stream wrapper. It holds the record that is registered
+ *  with the Zend engine, and has the static functions that the engine calls
+ *  to open urls, and to read from and write to the opened streams. These
+ *  functions pass the calls on to the Php::StreamWrapper and Php::Stream
+ *  objects that are created by the extension.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Class definition
+ */
+class StreamWrapperImpl
+{
+private:
+    /**
+     *  The record that is registered with the Zend engine
+     *  @var    php_stream_wrapper
+     */
+    php_stream_wrapper _wrapper;
+
+    /**
+     *  Is the wrapper registered?
+     *  @var    bool
+     */
+    bool _installed = false;
+
+    /**
+     *  Open a url
+     *  @param  wrapper
+     *  @param  filename
+     *  @param  mode
+     *  @param  options
+     *  @param  opened_path
+     *  @param  context
+     *  @return php_stream
+     */
+    static php_stream *open(php_stream_wrapper *wrapper, const char *filename, const char *mode, int options, char **opened_path, php_stream_context *context STREAMS_DC TSRMLS_DC);
+
+    /**
+     *  Retrieve information about a url
+     *  @param  wrapper
+     *  @param  url
+     *  @param  flags
+     *  @param  ssb
+     *  @param  context
+     *  @return int         0 on success
+     */
+    static int urlStat(php_stream_wrapper *wrapper, const char *url, int flags, php_stream_statbuf *ssb, php_stream_context *context TSRMLS_DC);
+
+    /**
+     *  Remove the resource behind a url
+     *  @param  wrapper
+     *  @param  url
+     *  @param  options
+     *  @param  context
+     *  @return int         1 on success
+     */
+    static int unlink(php_stream_wrapper *wrapper, const char *url, int options, php_stream_context *context TSRMLS_DC);
+
+    /**
+     *  Functions that operate on an opened stream
+     *  @param  stream
+     */
+    static size_t write(php_stream *stream, const char *buffer, size_t count TSRMLS_DC);
+    static size_t read(php_stream *stream, char *buffer, size_t count TSRMLS_DC);
+    static int close(php_stream *stream, int close_handle TSRMLS_DC);
+    static int flush(php_stream *stream TSRMLS_DC);
+    static int seek(php_stream *stream, off_t offset, int whence, off_t *newoffset TSRMLS_DC);
+    static int stat(php_stream *stream, php_stream_statbuf *ssb TSRMLS_DC);
+    static int option(php_stream *stream, int option, int value, void *ptrparam TSRMLS_DC);
+
+    /**
+     *  Convert stream information to the format of the Zend engine
+     *  @param  stat
+     *  @param  ssb
+     */
+    static void convert(const StreamStat &stat, php_stream_statbuf *ssb);
+
+    /**
+     *  Report an exception that was thrown by the extension
+     *  @param  exception
+     */
+    static void warning(const std::exception &exception TSRMLS_DC);
+
+    /**
+     *  The operations of the wrapper and of the streams
+     *  @return php_stream_wrapper_ops
+     */
+    static php_stream_wrapper_ops *wrapperOps();
+    static php_stream_ops *streamOps();
+
+public:
+    /**
+     *  Constructor
+     *  @param  base        The user supplied wrapper
+     */
+    StreamWrapperImpl(StreamWrapper *base);
+
+    /**
+     *  Destructor
+     */
+    virtual ~StreamWrapperImpl() {}
+
+    /**
+     *  Register the wrapper with the Zend engine
+     *  @param  protocol
+     */
+    void install(const char *protocol TSRMLS_DC);
+
+    /**
+     *  Unregister the wrapper
+     *  @param  protocol
+     */
+    void uninstall(const char *protocol TSRMLS_DC);
+};
+
+/**
+ *  End namespace
+ */
+}
+
@@ -31,7 +31,7 @@ Super REQUEST   (TRACK_VARS_REQUEST, "_REQUEST");
 Value Super::operator[](const std::string &key)
 {
     // we need the tsrm_ls pointer
-    TSRMLS_FETCH();
+    TSRMLS_CACHED_FETCH();
     
     // call zend_is_auto_global to ensure that the just-in-time globals are loaded
     if (_name) { zend_is_auto_global(_name, strlen(_name) TSRMLS_CC); _name = nullptr; }
@@ -52,7 +52,7 @@ Value Super::operator[](const std::string &key)
 Value Super::operator[](const char *key)
 {
     // we need the tsrm_ls pointer
-    TSRMLS_FETCH();
+    TSRMLS_CACHED_FETCH();
 
     // call zend_is_auto_global to ensure that the just-in-time globals are loaded
     if (_name) { zend_is_auto_global(_name, strlen(_name) TSRMLS_CC); _name = nullptr; }
@@ -64,7 +64,7 @@ public:
         if (!_iter) return;
         
         // we need the tsrm pointer
-        TSRMLS_FETCH();
+        TSRMLS_CACHED_FETCH();
         
         // call the iterator destructor
         if (_iter) _iter->funcs->dtor(_iter TSRMLS_CC);
@@ -78,7 +78,7 @@ public:
     virtual ValueIteratorImpl *clone() override
     {
         // we need the tsrm_ls variable
-        TSRMLS_FETCH();
+        TSRMLS_CACHED_FETCH();
         
         // construct iterator
         return new TraverseIterator(*this TSRMLS_CC);
@@ -95,7 +95,7 @@ public:
         if (!_iter) return false;
 
         // we need the tsrm_ls variable
-        TSRMLS_FETCH();
+        TSRMLS_CACHED_FETCH();
         
         // movw it forward
         _iter->funcs->move_forward(_iter TSRMLS_CC);
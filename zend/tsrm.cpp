@@ -0,0 +1,30 @@
+/**
+ *  Tsrm.cpp
+ *
+ *  The thread local variable that holds the tsrm_ls pointer
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 Copernica BV
+ */
+#include "includes.h"
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+#ifdef ZTS
+
+/**
+ *  The tsrm_ls pointer of the current thread
+ *  @var    void***
+ */
+thread_local void ***tsrm_cache = nullptr;
+
+#endif
+
+/**
+ *  End namespace
+ */
+}
+
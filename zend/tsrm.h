@@ -0,0 +1,69 @@
+/**
+ *  Tsrm.h
+ *
+ *  On a thread safe PHP build, almost every function of the Zend engine
+ *  needs the magic tsrm_ls pointer of the current thread. The Zend engine
+ *  passes it to all the functions that it calls, but the public API of
+ *  PHP-CPP does not have it, and has to look it up with TSRMLS_FETCH(). That
+ *  is a call to ts_resource_ex() plus a thread specific storage lookup, for
+ *  every array access and every function call.
+ *
+ *  Because the pointer never changes for as long as a thread runs, we
+ *  remember it in a thread local variable instead, and use the macro
+ *  TSRMLS_CACHED_FETCH() in places where TSRMLS_FETCH() was used.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+#ifdef ZTS
+
+/**
+ *  The tsrm_ls pointer of the current thread
+ *  @var    void***
+ */
+extern thread_local void ***tsrm_cache;
+
+/**
+ *  Retrieve the tsrm_ls pointer of the current thread
+ *  @return void***
+ */
+inline void ***tsrmFetch()
+{
+    // the pointer is only looked up the first time
+    if (tsrm_cache) return tsrm_cache;
+
+    // look it up, and remember it
+    return tsrm_cache = (void ***)ts_resource_ex(0, NULL);
+}
+
+/**
+ *  Macro to be used instead of TSRMLS_FETCH()
+ */
+#define TSRMLS_CACHED_FETCH()   void ***tsrm_ls = Php::tsrmFetch()
+
+/**
+ *  Macro to remember the tsrm_ls pointer that was passed by the Zend engine
+ */
+#define TSRMLS_CACHED_STORE()   Php::tsrm_cache = (void ***)tsrm_ls
+
+#else
+
+/**
+ *  Without thread safety there is nothing to fetch or remember
+ */
+#define TSRMLS_CACHED_FETCH()
+#define TSRMLS_CACHED_STORE()
+
+#endif
+
+/**
+ *  End namespace
+ */
+}
+
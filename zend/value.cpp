@@ -189,7 +189,7 @@ Value::Value(const Base *object)
     Z_OBJ_HANDLE_P(_val) = impl->handle();
     
     // we need the tsrm_ls variable
-    TSRMLS_FETCH();
+    TSRMLS_CACHED_FETCH();
 
     // we have to lookup the object in the object-table
     zend_object_store_bucket *obj_bucket = &EG(objects_store).object_buckets[impl->handle()];
@@ -416,7 +416,7 @@ Value &Value::operator=(Value &&value)
         else
         {
             // we need the tsrm_ls variable
-            TSRMLS_FETCH();
+            TSRMLS_CACHED_FETCH();
             
             // the last and only reference to the other object was
             // removed, we no longer need it
@@ -1239,7 +1239,7 @@ static Value do_exec(zval **object, zval *method, int argc, zval ***params)
     zval *retval = nullptr;
 
     // we need the tsrm_ls variable
-    TSRMLS_FETCH();
+    TSRMLS_CACHED_FETCH();
 
     // the current exception
     zval *oldException = EG(exception);
@@ -1341,7 +1341,7 @@ Value &Value::setType(Type type)
 bool Value::isCallable() const
 {
     // we need the tsrm_ls variable
-    TSRMLS_FETCH();
+    TSRMLS_CACHED_FETCH();
     
     // we can not rely on the type, because strings can be callable as well
     return zend_is_callable(_val, 0, NULL TSRMLS_CC);
@@ -1514,7 +1514,7 @@ int Value::size() const
         long result;
         
         // we need the tsrm_ls variable
-        TSRMLS_FETCH();
+        TSRMLS_CACHED_FETCH();
         
         // call the function
         return Z_OBJ_HT_P(_val)->count_elements(_val, &result TSRMLS_CC) == SUCCESS ? result : 0;
@@ -1571,7 +1571,7 @@ ValueIterator Value::createIterator(bool begin) const
     if (isObject()) 
     {
         // we need the TSRMLS_CC variable
-        TSRMLS_FETCH();
+        TSRMLS_CACHED_FETCH();
         
         // is a special iterator method defined in the class entry?
         auto *entry = zend_get_class_entry(_val TSRMLS_CC);
@@ -1654,7 +1654,7 @@ bool Value::contains(const char *key, int size) const
     else if (isObject())
     {
         // we need the tsrmls_cc variable
-        TSRMLS_FETCH();
+        TSRMLS_CACHED_FETCH();
         
         // retrieve the class entry
         auto *entry = zend_get_class_entry(_val TSRMLS_CC);
@@ -1721,7 +1721,7 @@ Value Value::get(const char *key, int size) const
     else
     {
         // we need the tsrm_ls variable
-        TSRMLS_FETCH();
+        TSRMLS_CACHED_FETCH();
         
         // retrieve the class entry
         auto *entry = zend_get_class_entry(_val TSRMLS_CC);
@@ -1793,7 +1793,7 @@ void Value::setRaw(const char *key, int size, const Value &value)
         SEPARATE_ZVAL_IF_NOT_REF(&_val);
 
         // we need the tsrm_ls variable
-        TSRMLS_FETCH();
+        TSRMLS_CACHED_FETCH();
 
         // retrieve the class entry
         auto *entry = zend_get_class_entry(_val TSRMLS_CC);
@@ -1887,7 +1887,7 @@ Base *Value::implementation() const
     if (!isObject()) return nullptr;
     
     // we need the tsrm_ls variable
-    TSRMLS_FETCH();
+    TSRMLS_CACHED_FETCH();
     
     // retrieve the mixed object that contains the base
     return ObjectImpl::find(_val TSRMLS_CC)->object();
@@ -1901,6 +1901,11 @@ Base *Value::implementation() const
  */
 std::ostream &operator<<(std::ostream &stream, const Value &value)
 {
+    // strings can be written without making a copy, but write() ignores the
+    // field width, so this is only done when no width was set
+    if (value.isString() && stream.width() == 0) return stream.write(value.rawValue(), value.size());
+    
+    // other types are converted first
     return stream << value.stringValue();
 }
 
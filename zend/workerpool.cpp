@@ -0,0 +1,385 @@
+/**
+ *  WorkerPool.cpp
+ *
+ *  Implementation of the pool of background threads
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 Copernica BV
+ */
+#include "includes.h"
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  The queue of a single thread
+ */
+struct WorkerQueue
+{
+    /**
+     *  Lock to protect the tasks, the owner takes tasks from the front,
+     *  other threads steal from the back
+     *  @var    std::mutex
+     */
+    std::mutex mutex;
+
+    /**
+     *  The pending tasks
+     *  @var    std::deque
+     */
+    std::deque<std::function<void()>> tasks;
+};
+
+/**
+ *  The state of the pool
+ */
+struct PoolState
+{
+    /**
+     *  Lock to protect starting and stopping, and to let idle threads sleep
+     *  @var    std::mutex
+     */
+    std::mutex mutex;
+
+    /**
+     *  Condition to wake up idle threads
+     *  @var    std::condition_variable
+     */
+    std::condition_variable condition;
+
+    /**
+     *  The queues, one for each thread
+     *  @var    std::vector
+     */
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+
+    /**
+     *  The threads
+     *  @var    std::vector
+     */
+    std::vector<std::thread> threads;
+
+    /**
+     *  Number of tasks in all queues
+     *  @var    std::atomic
+     */
+    std::atomic<size_t> pending{0};
+
+    /**
+     *  Counter to spread tasks from other threads over the queues
+     *  @var    size_t
+     */
+    size_t next = 0;
+
+    /**
+     *  Number of threads to start (0 for one per core)
+     *  @var    size_t
+     */
+    size_t size = 0;
+
+    /**
+     *  Maximum number of tasks per queue
+     *  @var    size_t
+     */
+    size_t capacity = 1024;
+
+    /**
+     *  Have the threads been started, or stopped?
+     *  @var    bool
+     */
+    bool started = false;
+    bool stopped = false;
+
+    /**
+     *  Have the fork handlers been installed?
+     *  @var    bool
+     */
+    bool forkable = false;
+};
+
+/**
+ *  The pool
+ */
+static PoolState pool;
+
+/**
+ *  Index of the queue that belongs to the current thread (or -1 if the
+ *  current thread is not part of the pool)
+ */
+static thread_local int current = -1;
+
+/**
+ *  Take a task from the queues
+ *  @param  index       Index of the queue of the calling thread
+ *  @param  task        Will be filled with the task
+ *  @return bool
+ */
+static bool take(size_t index, std::function<void()> &task)
+{
+    // number of queues
+    size_t count = pool.queues.size();
+
+    // start with the own queue, then try to steal from the others
+    for (size_t i = 0; i < count; i++)
+    {
+        // the queue to check
+        WorkerQueue *queue = pool.queues[(index + i) % count].get();
+
+        // lock the queue
+        std::lock_guard<std::mutex> lock(queue->mutex);
+
+        // skip empty queues
+        if (queue->tasks.empty()) continue;
+
+        // the own queue is handled in order, stolen tasks come from the back
+        if (i == 0)
+        {
+            task = std::move(queue->tasks.front());
+            queue->tasks.pop_front();
+        }
+        else
+        {
+            task = std::move(queue->tasks.back());
+            queue->tasks.pop_back();
+        }
+
+        // one task less
+        pool.pending--;
+
+        // done
+        return true;
+    }
+
+    // nothing found
+    return false;
+}
+
+/**
+ *  Main function of a thread in the pool
+ *  @param  index       Index of the queue of the thread
+ */
+static void work(size_t index)
+{
+    // remember the queue of this thread
+    current = (int)index;
+
+    // keep running
+    while (true)
+    {
+        // the next task
+        std::function<void()> task;
+
+        // run the task if there is one (exceptions end up in the future)
+        if (take(index, task)) { task(); continue; }
+
+        // lock the pool
+        std::unique_lock<std::mutex> lock(pool.mutex);
+
+        // a task could have been added in the meantime
+        if (pool.pending > 0) continue;
+
+        // are we done?
+        if (pool.stopped) return;
+
+        // wait for more work
+        pool.condition.wait(lock);
+    }
+}
+
+/**
+ *  Function that is called before the process forks, it locks the pool and
+ *  all queues, so that the child does not get a copy of a lock that is held
+ *  by a thread that does not exist in the child
+ */
+static void prepareFork()
+{
+    // lock the pool first, just like push() does
+    pool.mutex.lock();
+
+    // lock the queues
+    for (auto &queue : pool.queues) queue->mutex.lock();
+}
+
+/**
+ *  Function that is called in the parent after the fork
+ */
+static void parentFork()
+{
+    // unlock the queues
+    for (auto &queue : pool.queues) queue->mutex.unlock();
+
+    // unlock the pool
+    pool.mutex.unlock();
+}
+
+/**
+ *  Function that is called in the child after the fork, the threads of the 
+ *  pool were not copied to the child, so the pool starts over
+ */
+static void childFork()
+{
+    // unlock the queues and the pool
+    parentFork();
+
+    // the handles of the threads can not be joined, and destructing them 
+    // would terminate the process, so they are forgotten on purpose
+    new std::vector<std::thread>(std::move(pool.threads));
+    pool.threads.clear();
+
+    // the pending tasks are not run (the futures report a broken promise)
+    pool.queues.clear();
+    pool.pending = 0;
+
+    // the condition still has the waiting threads of the parent in its state,
+    // which would block a new waiter, so it is constructed again
+    new (&pool.condition) std::condition_variable();
+
+    // the threads are started again by the first task that is submitted
+    pool.started = false;
+}
+
+/**
+ *  Start the threads, the pool must be locked
+ */
+static void start()
+{
+    // the threads do not survive a fork, so the pool has to know about it
+    if (!pool.forkable) pthread_atfork(&prepareFork, &parentFork, &childFork);
+    pool.forkable = true;
+
+    // find out the number of threads
+    size_t size = pool.size > 0 ? pool.size : std::thread::hardware_concurrency();
+    if (size == 0) size = 1;
+
+    // create the queues first, the threads need all of them
+    for (size_t i = 0; i < size; i++) pool.queues.emplace_back(new WorkerQueue());
+
+    // start the threads
+    for (size_t i = 0; i < size; i++) pool.threads.emplace_back(work, i);
+
+    // the threads are running
+    pool.started = true;
+}
+
+/**
+ *  Set the number of threads and the size of the queues
+ *  @param  threads     Number of threads
+ *  @param  capacity    Maximum number of pending tasks per thread
+ */
+void WorkerPool::setup(size_t threads, size_t capacity)
+{
+    // lock the pool
+    std::lock_guard<std::mutex> lock(pool.mutex);
+
+    // the threads are already running
+    if (pool.started) return;
+
+    // store the settings
+    pool.size = threads;
+    pool.capacity = capacity > 0 ? capacity : 1;
+}
+
+/**
+ *  Number of threads in the pool
+ *  @return size_t
+ */
+size_t WorkerPool::size()
+{
+    // lock the pool
+    std::lock_guard<std::mutex> lock(pool.mutex);
+
+    // the number of running threads
+    return pool.threads.size();
+}
+
+/**
+ *  Add a task to the queues
+ *  @param  task
+ */
+void WorkerPool::push(std::function<void()> &&task)
+{
+    // tasks that are submitted by a task of the pool run right away, because
+    // the submitting task might wait for them while all threads are busy
+    if (current >= 0) return task();
+
+    // lock the pool
+    std::unique_lock<std::mutex> lock(pool.mutex);
+
+    // after shutdown, tasks run on the calling thread
+    if (pool.stopped)
+    {
+        // no need to keep the lock
+        lock.unlock();
+
+        // run the task
+        return task();
+    }
+
+    // start the threads the first time
+    if (!pool.started) start();
+
+    // the tasks are spread evenly over the queues
+    WorkerQueue *queue = pool.queues[pool.next++ % pool.queues.size()].get();
+
+    // lock the queue
+    std::unique_lock<std::mutex> queuelock(queue->mutex);
+
+    // is the queue full?
+    if (queue->tasks.size() >= pool.capacity)
+    {
+        // no need to keep the locks
+        queuelock.unlock();
+        lock.unlock();
+
+        // run the task on the calling thread
+        return task();
+    }
+
+    // add the task
+    queue->tasks.push_back(std::move(task));
+    pool.pending++;
+
+    // release the locks before waking up a thread
+    queuelock.unlock();
+    lock.unlock();
+
+    // wake up an idle thread
+    pool.condition.notify_one();
+}
+
+/**
+ *  Stop the threads, after the pending tasks are finished
+ */
+void WorkerPool::shutdown()
+{
+    // the threads to stop
+    std::vector<std::thread> threads;
+
+    // lock the pool
+    {
+        std::lock_guard<std::mutex> lock(pool.mutex);
+
+        // tasks can no longer be added
+        pool.stopped = true;
+
+        // take over the threads
+        threads.swap(pool.threads);
+    }
+
+    // wake up all threads, they stop when the queues are empty
+    pool.condition.notify_all();
+
+    // wait for them
+    for (auto &thread : threads) thread.join();
+
+    // the queues are no longer needed
+    pool.queues.clear();
+}
+
+/**
+ *  End namespace
+ */
+}
+
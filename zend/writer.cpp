@@ -0,0 +1,301 @@
+/**
+ *  Writer.cpp
+ *
+ *  Implementation of the Writer class
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 Copernica BV
+ */
+#include "includes.h"
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  All numbers from 00 to 99, so that integers can be converted two
+ *  digits at a time
+ *  @var    char[]
+ */
+static const char pairs[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+/**
+ *  Send the buffered data to the output buffer of Php::out
+ */
+void Writer::flush()
+{
+    // is there anything to send?
+    if (_size == 0) return;
+    
+    // pass it on to the stream buffer
+    out.rdbuf()->sputn(_buffer, _size);
+    
+    // the buffer is empty again
+    _size = 0;
+}
+
+/**
+ *  Write data that does not fit in the buffer
+ *  @param  data
+ *  @param  size
+ *  @return Writer
+ */
+Writer &Writer::writeLarge(const char *data, size_t size)
+{
+    // send out what we already have
+    flush();
+    
+    // data that is smaller than the buffer is still buffered
+    if (size <= sizeof(_buffer)) return write(data, size);
+    
+    // bigger data is passed on directly
+    out.rdbuf()->sputn(data, size);
+    
+    // allow chaining
+    return *this;
+}
+
+/**
+ *  Write a PHP value
+ *  @param  value
+ *  @return Writer
+ */
+Writer &Writer::write(const Value &value)
+{
+    // strings can be written without making a copy
+    if (value.isString()) return write(value.rawValue(), value.size());
+    
+    // other types are converted first
+    return write(value.stringValue());
+}
+
+/**
+ *  Write an unsigned integer
+ *  @param  value
+ *  @return Writer
+ */
+Writer &Writer::writeUnsigned(uint64_t value)
+{
+    // the digits are filled in from the back
+    char digits[20];
+    char *end = digits + sizeof(digits);
+    char *current = end;
+    
+    // two digits at a time
+    while (value >= 100)
+    {
+        // position of the pair
+        const char *pair = pairs + (value % 100) * 2;
+        value /= 100;
+        
+        // add the pair
+        *--current = pair[1];
+        *--current = pair[0];
+    }
+    
+    // the last one or two digits
+    if (value >= 10)
+    {
+        *--current = pairs[value * 2 + 1];
+        *--current = pairs[value * 2];
+    }
+    else *--current = '0' + value;
+    
+    // write the digits
+    return write(current, end - current);
+}
+
+/**
+ *  Write a signed integer
+ *  @param  value
+ *  @return Writer
+ */
+Writer &Writer::writeSigned(int64_t value)
+{
+    // positive numbers need no sign
+    if (value >= 0) return writeUnsigned(value);
+    
+    // write the sign, and the absolute value (this also works for the lowest number)
+    write('-');
+    return writeUnsigned(0 - (uint64_t)value);
+}
+
+/**
+ *  Write a floating point number
+ *  @param  value
+ *  @return Writer
+ */
+Writer &Writer::write(double value)
+{
+    // special values are written the same way as PHP does
+    if (std::isnan(value)) return write("NAN", 3);
+    if (std::isinf(value)) return value > 0 ? write("INF", 3) : write("-INF", 4);
+    
+    // numbers without a fraction are written as integers (the range is checked
+    // first, because converting a bigger number to an integer is undefined)
+    if (value > -1e15 && value < 1e15 && value == (double)(int64_t)value) return writeSigned((int64_t)value);
+    
+    // the decimal point of the locale, snprintf() uses it instead of a dot
+    const char *point = localeconv()->decimal_point;
+    size_t length = strlen(point);
+    
+    // buffer to format the number
+    char buffer[32];
+    int size = 0;
+    
+    // try the precisions that could be needed to read back the same number,
+    // most numbers only need fifteen digits
+    for (int precision = 15; precision <= 17; precision++)
+    {
+        // format the number
+        size = snprintf(buffer, sizeof(buffer), "%.*g", precision, value);
+        
+        // replace the decimal point of the locale by a dot
+        char *found = length > 0 && strcmp(point, ".") != 0 ? strstr(buffer, point) : nullptr;
+        if (found)
+        {
+            *found = '.';
+            memmove(found + 1, found + length, buffer + size - found - length + 1);
+            size -= length - 1;
+        }
+        
+        // does it give back the same number? (zend_strtod() always uses a dot)
+        if (zend_strtod(buffer, nullptr) == value) break;
+    }
+    
+    // write the number
+    return write(buffer, size);
+}
+
+/**
+ *  Write a string with the special HTML characters replaced by entities
+ *  @param  data
+ *  @param  size
+ *  @return Writer
+ */
+Writer &Writer::html(const char *data, size_t size)
+{
+    // start of the characters that do not have to be replaced
+    const char *begin = data;
+    const char *end = data + size;
+    
+    // loop through the characters
+    for (const char *current = data; current < end; current++)
+    {
+        // the replacement
+        const char *entity;
+        
+        // check the character
+        switch (*current) {
+        case '&':   entity = "&amp;"; break;
+        case '<':   entity = "&lt;"; break;
+        case '>':   entity = "&gt;"; break;
+        case '"':   entity = "&quot;"; break;
+        case '\'':  entity = "&#039;"; break;
+        default:    continue;
+        }
+        
+        // write the characters before it, and the entity
+        write(begin, current - begin);
+        write(entity);
+        
+        // continue after the character
+        begin = current + 1;
+    }
+    
+    // write the remaining characters
+    return write(begin, end - begin);
+}
+
+/**
+ *  Write a PHP value with the special HTML characters replaced by entities
+ *  @param  value
+ *  @return Writer
+ */
+Writer &Writer::html(const Value &value)
+{
+    // strings can be written without making a copy
+    if (value.isString()) return html(value.rawValue(), value.size());
+    
+    // other types are converted first
+    return html(value.stringValue());
+}
+
+/**
+ *  Write the contents of a JSON string
+ *  @param  data
+ *  @param  size
+ *  @return Writer
+ */
+Writer &Writer::json(const char *data, size_t size)
+{
+    // start of the characters that do not have to be escaped
+    const char *begin = data;
+    const char *end = data + size;
+    
+    // loop through the characters
+    for (const char *current = data; current < end; current++)
+    {
+        // the character
+        unsigned char c = *current;
+        
+        // most characters can be copied
+        if (c >= 0x20 && c != '"' && c != '\\') continue;
+        
+        // write the characters before it
+        write(begin, current - begin);
+        
+        // continue after the character
+        begin = current + 1;
+        
+        // write the escape sequence
+        switch (c) {
+        case '"':   write("\\\"", 2); break;
+        case '\\':  write("\\\\", 2); break;
+        case '\b':  write("\\b", 2); break;
+        case '\f':  write("\\f", 2); break;
+        case '\n':  write("\\n", 2); break;
+        case '\r':  write("\\r", 2); break;
+        case '\t':  write("\\t", 2); break;
+        default:
+            // other control characters are written as a unicode escape
+            char escape[7] = { '\\', 'u', '0', '0', "0123456789abcdef"[c >> 4], "0123456789abcdef"[c & 15], 0 };
+            write(escape, 6);
+            break;
+        }
+    }
+    
+    // write the remaining characters
+    return write(begin, end - begin);
+}
+
+/**
+ *  Write the contents of a JSON string from a PHP value
+ *  @param  value
+ *  @return Writer
+ */
+Writer &Writer::json(const Value &value)
+{
+    // strings can be written without making a copy
+    if (value.isString()) return json(value.rawValue(), value.size());
+    
+    // other types are converted first
+    return json(value.stringValue());
+}
+
+/**
+ *  End namespace
+ */
+}
+